@@ -32,6 +32,8 @@ public:
 
 	enum class ResolveMode { Simple, Lookup };
 	bool resolve(ResolveMode mode = ResolveMode::Simple);
+	// Lookup in the background, the callback gets the resolved candidate or nullopt on failure
+	void resolveAsync(std::function<void(optional<Candidate>)> callback) const;
 
 	Type type() const;
 	TransportType transportType() const;
@@ -12,6 +12,7 @@
 #include "common.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 
 namespace rtc {
@@ -52,6 +53,9 @@ public:
 	size_t availableAmount() const;      // total size available to receive
 	void onAvailable(std::function<void()> callback);
 
+	// Time of reception by the ICE transport of the last message received, if known
+	optional<std::chrono::steady_clock::time_point> lastArrivalTime() const;
+
 protected:
 	Channel(impl_ptr<impl::Channel> impl);
 };
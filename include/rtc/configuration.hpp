@@ -69,13 +69,23 @@ struct RTC_CPP_EXPORT Configuration {
 	optional<ProxyServer> proxyServer; // libnice only
 	optional<string> bindAddress;      // libjuice only, default any
 
+	// Certificate, generated if not specified
+	optional<string> certificatePemFile; // PEM content or file path
+	optional<string> keyPemFile;         // PEM content or file path
+	optional<string> keyPemPass;         // file only
+
 	// Options
 	CertificateType certificateType = CertificateType::Default;
 	TransportPolicy iceTransportPolicy = TransportPolicy::All;
 	bool enableIceTcp = false;    // libnice only
 	bool enableIceUdpMux = false; // libjuice only
+	bool enableIceLite = false;   // libnice only, host candidates and controlled role
 	bool disableAutoNegotiation = false;
 	bool forceMediaTransport = false;
+	// Mark RTP and RTCP packets ECT(1) for L4S (RFC 9331). The application must then react to
+	// congestion feedback with a scalable congestion controller, which is not provided.
+	bool enableEcn = false;
+	bool enableMediaPipelining = false; // run track media handlers off the transport thread
 
 	// Port range
 	uint16_t portRangeBegin = 1024;
@@ -86,6 +96,14 @@ struct RTC_CPP_EXPORT Configuration {
 
 	// Local maximum message size for Data Channels
 	optional<size_t> maxMessageSize;
+
+	// Send scheduler, enabled by setting a rate budget in bytes per second for the ICE path
+	// Waiting datagrams are sent with strict priority for audio, then video, then data
+	// Sends on the ICE transport are then serialized, including with libjuice
+	optional<size_t> sendRateBudget;
+	size_t audioSendQueueBudget = 64 * 1024; // max queued bytes before dropping
+	size_t videoSendQueueBudget = 1024 * 1024;
+	size_t dataSendQueueBudget = 256 * 1024;
 };
 
 } // namespace rtc
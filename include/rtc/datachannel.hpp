@@ -14,6 +14,7 @@
 #include "reliability.hpp"
 
 #include <type_traits>
+#include <vector>
 
 namespace rtc {
 
@@ -24,6 +25,9 @@ struct PeerConnection;
 
 } // namespace impl
 
+// When messages are received faster than the application consumes them, reading from the SCTP
+// association is paused until the receive queue drains. All DataChannels of a PeerConnection share
+// the association, so a slow reader on one channel also stalls reception on the other channels.
 class RTC_CPP_EXPORT DataChannel final : private CheshireCat<impl::DataChannel>, public Channel {
 public:
 	DataChannel(impl_ptr<impl::DataChannel> impl);
@@ -45,6 +49,12 @@ public:
 	template <typename Buffer> bool sendBuffer(const Buffer &buf);
 	template <typename Iterator> bool sendBuffer(Iterator first, Iterator last);
 
+	// Send the same message on multiple DataChannels. The data is shared between channels with the
+	// same stream id and reliability instead of being copied for each of them. Closed channels are
+	// skipped. Returns the number of channels the message was sent or buffered on.
+	static size_t Broadcast(const std::vector<shared_ptr<DataChannel>> &channels,
+	                        message_variant data);
+
 private:
 	using CheshireCat<impl::DataChannel>::impl;
 };
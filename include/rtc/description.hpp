@@ -52,10 +52,12 @@ public:
 	optional<string> iceUfrag() const;
 	optional<string> icePwd() const;
 	optional<string> fingerprint() const;
+	bool iceLite() const;
 	bool ended() const;
 
 	void hintType(Type type);
 	void setFingerprint(string fingerprint);
+	void setIceLite(bool lite);
 	void addIceOption(string option);
 	void removeIceOption(const string &option);
 
@@ -286,6 +288,7 @@ private:
 	std::vector<string> mIceOptions;
 	optional<string> mIceUfrag, mIcePwd;
 	optional<string> mFingerprint;
+	bool mIceLite = false;
 	std::vector<string> mAttributes; // other attributes
 
 	// Entries
@@ -52,6 +52,16 @@ struct SctpSettings {
 
 RTC_CPP_EXPORT void SetSctpSettings(SctpSettings s);
 
+struct CertificateSettings {
+	// Number of certificates of each type generated in advance in the background, not set or 0
+	// means certificates are generated on demand
+	optional<size_t> poolSize;
+	// If set, PeerConnections share the same certificate, which is renewed once it gets older
+	optional<std::chrono::seconds> rotationInterval;
+};
+
+RTC_CPP_EXPORT void SetCertificateSettings(CertificateSettings s);
+
 } // namespace rtc
 
 RTC_CPP_EXPORT std::ostream &operator<<(std::ostream &out, rtc::LogLevel level);
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_H264_RTP_DEPACKETIZER_H
+#define RTC_H264_RTP_DEPACKETIZER_H
+
+#if RTC_ENABLE_MEDIA
+
+#include "common.hpp"
+#include "mediahandlerelement.hpp"
+#include "nalunit.hpp"
+
+#include <vector>
+
+namespace rtc {
+
+/// RTP depacketization of h264 payload (RFC 6184, non-interleaved mode)
+/// Single NAL unit packets, STAP-A and FU-A packets are reassembled into access units, which are
+/// passed downstream as whole messages once complete. The end of an access unit is detected with
+/// the marker bit, or with a change of RTP timestamp if the last packet was lost. Packets are
+/// expected in order, a fragmented NAL unit with a missing fragment is dropped. At most one access
+/// unit is passed per packet: if a packet both ends an access unit whose last packet was lost and
+/// completes the next one, only the complete one is passed.
+class RTC_CPP_EXPORT H264RtpDepacketizer final : public MediaHandlerElement {
+public:
+	using Separator = NalUnit::Separator;
+
+	/// Constructs h264 payload depacketizer
+	/// @param separator NAL unit separator in the access units passed downstream
+	H264RtpDepacketizer(Separator separator = Separator::LongStartSequence);
+
+	ChainedIncomingProduct processIncomingBinaryMessage(ChainedMessagesProduct messages) override;
+
+private:
+	/// Part of a received packet, referenced instead of copied until the access unit is complete
+	struct Slice {
+		binary_ptr packet;
+		size_t offset;
+		size_t length;
+	};
+
+	struct Unit {
+		std::byte header;
+		std::vector<Slice> slices; // payload following the NAL unit header
+	};
+
+	void processPacket(binary_ptr packet, std::vector<binary_ptr> &output);
+	void addUnit(binary_ptr packet, size_t offset, size_t length);
+	void addFragment(binary_ptr packet, size_t offset, size_t length);
+	binary_ptr buildAccessUnit();
+
+	const Separator separator;
+
+	std::vector<Unit> units;   // complete NAL units of the current access unit
+	optional<Unit> fragmented; // FU-A unit in progress
+	optional<uint32_t> timestamp;
+	optional<uint16_t> nextSeqNumber;
+};
+
+} // namespace rtc
+
+#endif /* RTC_ENABLE_MEDIA */
+
+#endif /* RTC_H264_RTP_DEPACKETIZER_H */
@@ -35,6 +35,7 @@ public:
 	message_ptr outgoing(message_ptr ptr) override;
 
 	bool send(message_ptr msg);
+	bool sendBatch(message_vector msgs); // false if no batch callback is set
 
 	/// Adds element to chain
 	/// @param chainable Chainable element
@@ -19,6 +19,8 @@ class RTC_CPP_EXPORT MediaHandler {
 protected:
 	// Use this callback when trying to send custom data (such as RTCP) to the client.
 	synchronized_callback<message_ptr> outgoingCallback;
+	// Use this callback to send a burst of packets at once, it might not be set.
+	synchronized_callback<message_vector> outgoingBatchCallback;
 
 public:
 	// Called when there is traffic coming from the peer
@@ -32,6 +34,11 @@ public:
 		this->outgoingCallback = synchronized_callback<message_ptr>(cb);
 	}
 
+	// This callback is used to send a burst of packets back to the peer in one call.
+	void onOutgoingBatch(const std::function<void(message_vector)> &cb) {
+		this->outgoingBatchCallback = synchronized_callback<message_vector>(cb);
+	}
+
 	virtual bool requestKeyframe() { return false; }
 };
 
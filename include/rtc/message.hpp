@@ -12,6 +12,7 @@
 #include "common.hpp"
 #include "reliability.hpp"
 
+#include <chrono>
 #include <functional>
 
 namespace rtc {
@@ -32,9 +33,13 @@ struct RTC_CPP_EXPORT Message : binary {
 	unsigned int stream = 0; // Stream id (SCTP stream or SSRC)
 	unsigned int dscp = 0;   // Differentiated Services Code Point
 	shared_ptr<Reliability> reliability;
+
+	// Time of reception by the ICE transport, for incoming messages only
+	optional<std::chrono::steady_clock::time_point> arrivalTime;
 };
 
 using message_ptr = shared_ptr<Message>;
+using message_vector = std::vector<message_ptr>;
 using message_callback = std::function<void(message_ptr message)>;
 
 inline size_t message_size_func(const message_ptr &m) {
@@ -35,6 +35,17 @@ struct RTC_CPP_EXPORT DataChannelInit {
 	string protocol = "";
 };
 
+struct RTC_CPP_EXPORT SendQueueStats {
+	struct Queue {
+		size_t packets = 0;   // currently queued
+		size_t bytes = 0;     // same
+		size_t peakBytes = 0; // max queued since stats were cleared
+		size_t dropped = 0;   // packets dropped as the queue budget was exceeded
+	};
+
+	Queue audio, video, data;
+};
+
 class RTC_CPP_EXPORT PeerConnection final : CheshireCat<impl::PeerConnection> {
 public:
 	enum class State : int {
@@ -72,6 +83,7 @@ public:
 
 	PeerConnection();
 	PeerConnection(Configuration config);
+	PeerConnection(impl_ptr<impl::PeerConnection> impl);
 	~PeerConnection();
 
 	void close();
@@ -93,6 +105,7 @@ public:
 	void setLocalDescription(Description::Type type = Description::Type::Unspec);
 	void setRemoteDescription(Description description);
 	void addRemoteCandidate(Candidate candidate);
+	void restartIce(); // keeps DTLS and SCTP, renegotiates with new ICE credentials
 
 	void setMediaHandler(shared_ptr<MediaHandler> handler);
 	shared_ptr<MediaHandler> getMediaHandler();
@@ -117,7 +130,9 @@ public:
 	void clearStats();
 	size_t bytesSent();
 	size_t bytesReceived();
+	size_t messagesSuperseded(); // unsent messages replaced with the latest-only policy
 	optional<std::chrono::milliseconds> rtt();
+	SendQueueStats sendQueueStats(); // empty unless Configuration::sendRateBudget is set
 };
 
 } // namespace rtc
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_PEER_CONNECTION_POOL_H
+#define RTC_PEER_CONNECTION_POOL_H
+
+#include "common.hpp"
+#include "configuration.hpp"
+#include "peerconnection.hpp"
+
+#include <chrono>
+
+namespace rtc {
+
+namespace impl {
+
+struct PeerConnectionPool;
+
+}
+
+// Keeps PeerConnections created in advance with the same configuration, with their certificate
+// ready, their ICE transport set up and their local candidates gathered, and refills in the
+// background as they are handed out. Gathered candidates are part of the first local description.
+class RTC_CPP_EXPORT PeerConnectionPool final : private CheshireCat<impl::PeerConnectionPool> {
+public:
+	struct Stats {
+		size_t hits = 0;   // PeerConnections handed out from the pool
+		size_t misses = 0; // PeerConnections created on demand as the pool was empty
+		std::chrono::microseconds averageAcquireTime{0};
+		std::chrono::microseconds maxAcquireTime{0};
+	};
+
+	PeerConnectionPool(Configuration config, size_t size);
+	~PeerConnectionPool();
+
+	void close();
+
+	shared_ptr<PeerConnection> acquire();
+	size_t available() const;
+
+	// Stats
+	Stats stats() const;
+	void clearStats();
+
+private:
+	using CheshireCat<impl::PeerConnectionPool>::impl;
+};
+
+} // namespace rtc
+
+#endif
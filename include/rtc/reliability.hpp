@@ -21,6 +21,12 @@ struct Reliability {
 	Type type = Type::Reliable;
 	bool unordered = false;
 	variant<int, std::chrono::milliseconds> rexmit = 0;
+
+	// If true, a new message replaces any message still waiting to be sent on the same channel,
+	// so only the latest value is delivered under congestion. This is a local sending policy, it
+	// is not negotiated with the remote peer. As it drops messages, it requires the channel to be
+	// unordered or partially reliable, creating a reliable ordered channel with it throws.
+	bool latestOnly = false;
 };
 
 } // namespace rtc
@@ -15,6 +15,7 @@
 //
 #include "datachannel.hpp"
 #include "peerconnection.hpp"
+#include "peerconnectionpool.hpp"
 #include "track.hpp"
 
 #if RTC_ENABLE_WEBSOCKET
@@ -37,6 +38,7 @@
 #include "aacrtppacketizer.hpp"
 #include "av1packetizationhandler.hpp"
 #include "h264packetizationhandler.hpp"
+#include "h264rtpdepacketizer.hpp"
 #include "h265packetizationhandler.hpp"
 #include "opuspacketizationhandler.hpp"
 
@@ -338,6 +338,51 @@ struct RTC_CPP_EXPORT RtcpNack {
 	bool addMissingPacket(unsigned int *fciCount, uint16_t *fciPID, uint16_t missingPacket);
 };
 
+// RFC 8888: RTP Control Protocol (RTCP) Feedback for Congestion Control
+struct RTC_CPP_EXPORT RtcpCcfbMetric {
+	uint16_t _value; // R (1 bit), ECN (2 bits), Arrival time offset (13 bits)
+
+	[[nodiscard]] bool received() const;
+	[[nodiscard]] uint8_t ecn() const;
+	[[nodiscard]] uint16_t arrivalTimeOffset() const; // in 1/1024 seconds
+
+	void set(bool received, uint8_t ecn, uint16_t arrivalTimeOffset);
+};
+
+struct RTC_CPP_EXPORT RtcpCcfbBlock {
+	SSRC _ssrc;
+	uint16_t _beginSeq;
+	uint16_t _numReports;
+	RtcpCcfbMetric metrics[1];
+
+	[[nodiscard]] static size_t Size(unsigned int count); // padded to 32 bits
+
+	[[nodiscard]] SSRC ssrc() const;
+	[[nodiscard]] uint16_t beginSeq() const;
+	[[nodiscard]] unsigned int metricsCount() const;
+	[[nodiscard]] size_t getSize() const;
+
+	void prepareBlock(SSRC ssrc, uint16_t beginSeq, unsigned int count);
+};
+
+struct RTC_CPP_EXPORT RtcpCcfb {
+	RtcpHeader header;
+	SSRC _senderSSRC;
+	// Followed by report blocks and the 32-bit report timestamp
+
+	[[nodiscard]] static size_t Size(size_t blocksSize);
+
+	[[nodiscard]] SSRC senderSSRC() const;
+	[[nodiscard]] uint32_t reportTimestamp() const; // middle 32 bits of the NTP timestamp
+	[[nodiscard]] std::vector<const RtcpCcfbBlock *> blocks() const;
+	[[nodiscard]] unsigned int congestionExperiencedCount() const;
+
+	[[nodiscard]] RtcpCcfbBlock *getBlock(size_t offset); // offset in bytes after the SSRC
+
+	void preparePacket(SSRC senderSSRC, size_t blocksSize);
+	void setReportTimestamp(uint32_t timestamp);
+};
+
 struct RTC_CPP_EXPORT RtpRtx {
 	RtpHeader header;
 
@@ -9,6 +9,7 @@
 #include "candidate.hpp"
 
 #include "impl/internals.hpp"
+#include "impl/resolver.hpp"
 
 #include <algorithm>
 #include <array>
@@ -48,6 +49,16 @@ inline void trim_end(string &str) {
 	    str.end());
 }
 
+inline int socktype_of(rtc::Candidate::TransportType transportType) {
+	using TransportType = rtc::Candidate::TransportType;
+	if (transportType == TransportType::Udp)
+		return SOCK_DGRAM;
+	else if (transportType != TransportType::Unknown)
+		return SOCK_STREAM;
+	else
+		return 0;
+}
+
 } // namespace
 
 namespace rtc {
@@ -153,49 +164,49 @@ bool Candidate::resolve(ResolveMode mode) {
 	             << (mode == ResolveMode::Simple ? "simple" : "lookup") << "): " << mNode << ' '
 	             << mService;
 
-	// Try to resolve the node and service
-	struct addrinfo hints = {};
-	hints.ai_family = AF_UNSPEC;
-	hints.ai_flags = AI_ADDRCONFIG;
-	if (mTransportType == TransportType::Udp) {
-		hints.ai_socktype = SOCK_DGRAM;
-		hints.ai_protocol = IPPROTO_UDP;
-	} else if (mTransportType != TransportType::Unknown) {
-		hints.ai_socktype = SOCK_STREAM;
-		hints.ai_protocol = IPPROTO_TCP;
-	}
-
-	if (mode == ResolveMode::Simple)
-		hints.ai_flags |= AI_NUMERICHOST;
-
-	struct addrinfo *result = nullptr;
-	if (getaddrinfo(mNode.c_str(), mService.c_str(), &hints, &result) == 0) {
-		for (auto p = result; p; p = p->ai_next) {
-			if (p->ai_family == AF_INET || p->ai_family == AF_INET6) {
-				char nodebuffer[MAX_NUMERICNODE_LEN];
-				char servbuffer[MAX_NUMERICSERV_LEN];
-				if (getnameinfo(p->ai_addr, socklen_t(p->ai_addrlen), nodebuffer,
-				                MAX_NUMERICNODE_LEN, servbuffer, MAX_NUMERICSERV_LEN,
-				                NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
-					try {
-						mPort = uint16_t(std::stoul(servbuffer));
-					} catch (...) {
-						return false;
-					}
-					mAddress = nodebuffer;
-					mFamily = p->ai_family == AF_INET6 ? Family::Ipv6 : Family::Ipv4;
-					PLOG_VERBOSE << "Resolved candidate: " << mAddress << ' ' << mPort;
-					break;
+	// Try to resolve the node and service, lookups are served from the shared cache if possible
+	int socktype = socktype_of(mTransportType);
+	auto addresses = mode == ResolveMode::Simple
+	                     ? impl::Resolver::Numeric(mNode, mService, socktype)
+	                     : impl::Resolver::Instance().resolve(mNode, mService, socktype);
+	if (addresses) {
+		for (const auto &[addr, addrlen] : *addresses) {
+			char nodebuffer[MAX_NUMERICNODE_LEN];
+			char servbuffer[MAX_NUMERICSERV_LEN];
+			if (getnameinfo(reinterpret_cast<const struct sockaddr *>(&addr), addrlen, nodebuffer,
+			                MAX_NUMERICNODE_LEN, servbuffer, MAX_NUMERICSERV_LEN,
+			                NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
+				try {
+					mPort = uint16_t(std::stoul(servbuffer));
+				} catch (...) {
+					return false;
 				}
+				mAddress = nodebuffer;
+				mFamily = addr.ss_family == AF_INET6 ? Family::Ipv6 : Family::Ipv4;
+				PLOG_VERBOSE << "Resolved candidate: " << mAddress << ' ' << mPort;
+				break;
 			}
 		}
-
-		freeaddrinfo(result);
 	}
 
 	return mFamily != Family::Unresolved;
 }
 
+void Candidate::resolveAsync(std::function<void(optional<Candidate>)> callback) const {
+	PLOG_VERBOSE << "Resolving candidate in the background: " << mNode << ' ' << mService;
+
+	// The lookup runs on the resolver threads and fills the shared cache, then the candidate is
+	// resolved from it
+	impl::Resolver::Instance().resolve(
+	    mNode, mService, socktype_of(mTransportType),
+	    [candidate = *this, callback = std::move(callback)](auto addresses) mutable {
+		    if (addresses && candidate.resolve(ResolveMode::Lookup))
+			    callback(std::move(candidate));
+		    else
+			    callback(nullopt);
+	    });
+}
+
 Candidate::Type Candidate::type() const { return mType; }
 
 Candidate::TransportType Candidate::transportType() const { return mTransportType; }
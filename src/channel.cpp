@@ -59,4 +59,12 @@ size_t Channel::availableAmount() const { return impl()->availableAmount(); }
 
 void Channel::onAvailable(std::function<void()> callback) { impl()->availableCallback = callback; }
 
+optional<std::chrono::steady_clock::time_point> Channel::lastArrivalTime() const {
+	auto time = impl()->lastArrivalTime.load();
+	if (time == std::chrono::steady_clock::time_point())
+		return nullopt;
+
+	return time;
+}
+
 } // namespace rtc
@@ -54,4 +54,15 @@ bool DataChannel::send(const byte *data, size_t size) {
 	return impl()->outgoing(std::make_shared<Message>(data, data + size, Message::Binary));
 }
 
+size_t DataChannel::Broadcast(const std::vector<shared_ptr<DataChannel>> &channels,
+                              message_variant data) {
+	std::vector<shared_ptr<impl::DataChannel>> impls;
+	impls.reserve(channels.size());
+	for (const auto &channel : channels)
+		if (channel)
+			impls.emplace_back(channel->impl());
+
+	return impl::DataChannel::Broadcast(impls, make_message(std::move(data)));
+}
+
 } // namespace rtc
@@ -144,6 +144,11 @@ Description::Description(const string &sdp, Type type, Role role)
 				// takes precedence.
 				if (!mIcePwd || index == 0) // media-level for first media overrides session-level
 					mIcePwd = value;
+			} else if (key == "ice-lite") {
+				// RFC 8839: The "ice-lite" attribute is a session-level attribute only, and
+				// indicates that an agent is a lite implementation.
+				if (index == -1)
+					mIceLite = true;
 			} else if (key == "ice-options") {
 				// RFC 8839: The "ice-options" attribute is a session-level and media-level
 				// attribute.
@@ -198,6 +203,8 @@ std::vector<string> Description::iceOptions() const { return mIceOptions; }
 
 optional<string> Description::icePwd() const { return mIcePwd; }
 
+bool Description::iceLite() const { return mIceLite; }
+
 optional<string> Description::fingerprint() const { return mFingerprint; }
 
 bool Description::ended() const { return mEnded; }
@@ -216,6 +223,8 @@ void Description::setFingerprint(string fingerprint) {
 	mFingerprint.emplace(std::move(fingerprint));
 }
 
+void Description::setIceLite(bool lite) { mIceLite = lite; }
+
 void Description::addIceOption(string option) {
 	if (std::find(mIceOptions.begin(), mIceOptions.end(), option) == mIceOptions.end())
 		mIceOptions.emplace_back(std::move(option));
@@ -301,6 +310,8 @@ string Description::generateSdp(string_view eol) const {
 	sdp << "a=msid-semantic:WMS *" << eol;
 	sdp << "a=setup:" << mRole << eol;
 
+	if (mIceLite)
+		sdp << "a=ice-lite" << eol;
 	if (mIceUfrag)
 		sdp << "a=ice-ufrag:" << *mIceUfrag << eol;
 	if (mIcePwd)
@@ -364,6 +375,8 @@ string Description::generateApplicationSdp(string_view eol) const {
 	sdp << "a=msid-semantic:WMS *" << eol;
 	sdp << "a=setup:" << mRole << eol;
 
+	if (mIceLite)
+		sdp << "a=ice-lite" << eol;
 	if (mIceUfrag)
 		sdp << "a=ice-ufrag:" << *mIceUfrag << eol;
 	if (mIcePwd)
@@ -16,6 +16,7 @@
 //
 #include "global.hpp"
 
+#include "impl/certificate.hpp"
 #include "impl/init.hpp"
 
 #include <mutex>
@@ -88,6 +89,10 @@ std::shared_future<void> Cleanup() { return impl::Init::Instance().cleanup(); }
 
 void SetSctpSettings(SctpSettings s) { impl::Init::Instance().setSctpSettings(std::move(s)); }
 
+void SetCertificateSettings(CertificateSettings s) {
+	impl::CertificateProvider::Instance().setSettings(std::move(s));
+}
+
 } // namespace rtc
 
 RTC_CPP_EXPORT std::ostream &operator<<(std::ostream &out, rtc::LogLevel level) {
@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#if RTC_ENABLE_MEDIA
+
+#include "h264rtpdepacketizer.hpp"
+
+#include "impl/internals.hpp"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#endif
+
+namespace rtc {
+
+// RFC 6184 5.2: NAL unit types used as payload structure types
+const uint8_t naluTypeSTAPA = 24;
+const uint8_t naluTypeFUA = 28;
+
+H264RtpDepacketizer::H264RtpDepacketizer(Separator separator)
+    : MediaHandlerElement(), separator(separator) {}
+
+ChainedIncomingProduct
+H264RtpDepacketizer::processIncomingBinaryMessage(ChainedMessagesProduct messages) {
+	auto output = make_chained_messages_product();
+	for (const auto &packet : *messages)
+		if (packet)
+			processPacket(packet, *output);
+
+	if (output->empty())
+		return {nullptr};
+
+	return {output};
+}
+
+void H264RtpDepacketizer::processPacket(binary_ptr packet, std::vector<binary_ptr> &output) {
+	if (packet->size() < sizeof(RtpHeader)) {
+		LOG_VERBOSE << "RTP packet is too short, size=" << packet->size();
+		return;
+	}
+
+	auto rtp = reinterpret_cast<const RtpHeader *>(packet->data());
+	size_t begin = rtp->getSize();
+	if (rtp->extension()) {
+		if (packet->size() < begin + sizeof(RtpExtensionHeader)) {
+			LOG_VERBOSE << "RTP packet is too short for header extension, size=" << packet->size();
+			return;
+		}
+		begin += rtp->getExtensionHeaderSize();
+	}
+
+	size_t end = packet->size();
+	if (rtp->padding() && end > begin)
+		end -= std::min(size_t(std::to_integer<uint8_t>(packet->back())), end - begin);
+
+	if (begin >= end) {
+		LOG_VERBOSE << "RTP packet has no payload";
+		return;
+	}
+
+	// Packets of an access unit share the same timestamp, so a new timestamp means the previous
+	// access unit ended even though the packet with the marker bit was not received
+	binary_ptr unterminated;
+	if (timestamp && *timestamp != rtp->timestamp())
+		unterminated = buildAccessUnit();
+
+	if (nextSeqNumber && *nextSeqNumber != rtp->seqNumber() && fragmented) {
+		LOG_VERBOSE << "Packet loss, dropping fragmented NAL unit";
+		fragmented.reset();
+	}
+
+	timestamp = rtp->timestamp();
+	nextSeqNumber = uint16_t(rtp->seqNumber() + 1);
+
+	auto nalu = reinterpret_cast<const NalUnitHeader *>(packet->data() + begin);
+	uint8_t type = nalu->unitType();
+	if (type != naluTypeFUA && fragmented) {
+		LOG_VERBOSE << "Missing end of fragmented NAL unit, dropping it";
+		fragmented.reset();
+	}
+
+	if (type >= 1 && type <= 23) {
+		addUnit(packet, begin, end - begin);
+
+	} else if (type == naluTypeSTAPA) {
+		// RFC 6184 5.7.1: STAP-A NAL header followed by units prefixed with a 16-bit size
+		size_t index = begin + 1;
+		while (index + 2 <= end) {
+			size_t size = size_t(std::to_integer<uint8_t>(packet->at(index))) << 8 |
+			              std::to_integer<uint8_t>(packet->at(index + 1));
+			index += 2;
+			if (size == 0 || index + size > end) {
+				LOG_WARNING << "Invalid STAP-A aggregation unit size, ignoring";
+				break;
+			}
+
+			addUnit(packet, index, size);
+			index += size;
+		}
+
+	} else if (type == naluTypeFUA) {
+		addFragment(packet, begin, end - begin);
+
+	} else {
+		LOG_VERBOSE << "Unsupported H264 payload structure type " << unsigned(type) << ", ignoring";
+	}
+
+	// At most one access unit is passed per packet, as the media handler chain delivers a single
+	// message, so the complete access unit supersedes the unterminated one
+	if (rtp->marker()) {
+		if (auto accessUnit = buildAccessUnit()) {
+			if (unterminated)
+				LOG_VERBOSE << "Dropping access unit without marker bit, superseded by next one";
+
+			output.push_back(std::move(accessUnit));
+			return;
+		}
+	}
+
+	if (unterminated)
+		output.push_back(std::move(unterminated));
+}
+
+void H264RtpDepacketizer::addUnit(binary_ptr packet, size_t offset, size_t length) {
+	Unit unit{packet->at(offset), {}};
+	if (length > 1)
+		unit.slices.push_back(Slice{std::move(packet), offset + 1, length - 1});
+
+	units.push_back(std::move(unit));
+}
+
+void H264RtpDepacketizer::addFragment(binary_ptr packet, size_t offset, size_t length) {
+	// RFC 6184 5.8: FU indicator and FU header precede the fragment
+	if (length < 2) {
+		LOG_VERBOSE << "FU-A packet is too short, ignoring";
+		return;
+	}
+
+	auto indicator = reinterpret_cast<const NalUnitHeader *>(packet->data() + offset);
+	auto fuHeader = reinterpret_cast<const NalUnitFragmentHeader *>(packet->data() + offset + 1);
+	if (fuHeader->isStart()) {
+		if (fragmented) {
+			LOG_VERBOSE << "Missing end of fragmented NAL unit, dropping it";
+			fragmented.reset();
+		}
+
+		// The original NAL unit header is rebuilt from the FU indicator and the FU header
+		NalUnitHeader header;
+		header.setForbiddenBit(indicator->forbiddenBit());
+		header.setNRI(indicator->nri());
+		header.setUnitType(fuHeader->unitType());
+		fragmented.emplace(Unit{std::byte(header._first), {}});
+
+	} else if (!fragmented) {
+		LOG_VERBOSE << "Missing start of fragmented NAL unit, ignoring fragment";
+		return;
+	}
+
+	if (length > 2)
+		fragmented->slices.push_back(Slice{packet, offset + 2, length - 2});
+
+	if (fuHeader->isEnd()) {
+		units.push_back(std::move(*fragmented));
+		fragmented.reset();
+	}
+}
+
+binary_ptr H264RtpDepacketizer::buildAccessUnit() {
+	if (fragmented) {
+		LOG_VERBOSE << "Missing end of fragmented NAL unit, dropping it";
+		fragmented.reset();
+	}
+
+	if (units.empty())
+		return nullptr;
+
+	const size_t separatorSize = separator == Separator::ShortStartSequence ? 3 : 4;
+
+	// Slices are copied once, straight into the access unit
+	auto unitSize = [](const Unit &unit) {
+		size_t size = 1;
+		for (const auto &slice : unit.slices)
+			size += slice.length;
+
+		return size;
+	};
+
+	size_t total = 0;
+	for (const auto &unit : units)
+		total += separatorSize + unitSize(unit);
+
+	auto accessUnit = std::make_shared<binary>(total);
+	std::byte *p = accessUnit->data();
+	for (const auto &unit : units) {
+		if (separator == Separator::Length) {
+			uint32_t length = htonl(uint32_t(unitSize(unit)));
+			std::memcpy(p, &length, 4);
+		} else {
+			std::memset(p, 0, separatorSize);
+			p[separatorSize - 1] = std::byte(0x01);
+		}
+		p += separatorSize;
+
+		*p++ = unit.header;
+		for (const auto &slice : unit.slices) {
+			std::memcpy(p, slice.packet->data() + slice.offset, slice.length);
+			p += slice.length;
+		}
+	}
+
+	units.clear();
+	return accessUnit;
+}
+
+} // namespace rtc
+
+#endif /* RTC_ENABLE_MEDIA */
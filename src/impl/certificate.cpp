@@ -491,12 +491,125 @@ string make_fingerprint(X509 *x509) {
 
 // Common for GnuTLS, Mbed TLS, and OpenSSL
 
-future_certificate_ptr make_certificate(CertificateType type) {
+namespace {
+
+const string PemBeginCertificateTag = "-----BEGIN CERTIFICATE-----";
+
+future_certificate_ptr generate_certificate(CertificateType type) {
 	return ThreadPool::Instance().enqueue([type, token = Init::Instance().token()]() {
 		return std::make_shared<Certificate>(Certificate::Generate(type, "libdatachannel"));
 	});
 }
 
+} // namespace
+
+future_certificate_ptr make_certificate(CertificateType type) {
+	return CertificateProvider::Instance().get(type);
+}
+
+future_certificate_ptr make_certificate(const Configuration &config) {
+	if (!config.certificatePemFile && !config.keyPemFile)
+		return make_certificate(config.certificateType);
+
+	if (!config.certificatePemFile || !config.keyPemFile)
+		throw std::invalid_argument(
+		    "Either none or both certificate and key PEM files must be specified");
+
+	std::promise<certificate_ptr> promise;
+	promise.set_value(CertificateProvider::Instance().load(
+	    *config.certificatePemFile, *config.keyPemFile, config.keyPemPass.value_or("")));
+	return promise.get_future().share();
+}
+
+CertificateProvider &CertificateProvider::Instance() {
+	static CertificateProvider *instance = new CertificateProvider;
+	return *instance;
+}
+
+future_certificate_ptr CertificateProvider::get(CertificateType type) {
+	std::lock_guard lock(mMutex);
+	if (!mSettings.rotationInterval)
+		return take(type);
+
+	// Reuse the shared certificate until it must be rotated
+	auto now = std::chrono::steady_clock::now();
+	auto it = mShared.find(type);
+	if (it == mShared.end() || now - it->second.createdAt >= *mSettings.rotationInterval) {
+		PLOG_DEBUG << "Rotating shared certificate";
+		it = mShared.insert_or_assign(type, Shared{take(type), now}).first;
+	}
+
+	return it->second.certificate;
+}
+
+certificate_ptr CertificateProvider::load(const string &crt_pem, const string &key_pem,
+                                          const string &pass) {
+	// Files are read on every load so that a certificate renewed in place is picked up
+	if (crt_pem.find(PemBeginCertificateTag) == string::npos)
+		return std::make_shared<Certificate>(Certificate::FromFile(crt_pem, key_pem, pass));
+
+	// Connections loading the same inline PEM share the certificate as long as one of them is alive
+	std::lock_guard lock(mMutex);
+
+	// Purge expired entries so the key text is not kept once the certificate is released
+	for (auto it = mLoaded.begin(); it != mLoaded.end();)
+		it = it->second.expired() ? mLoaded.erase(it) : std::next(it);
+
+	auto key = std::make_pair(crt_pem, key_pem);
+	if (auto it = mLoaded.find(key); it != mLoaded.end())
+		if (auto certificate = it->second.lock())
+			return certificate;
+
+	auto certificate = std::make_shared<Certificate>(Certificate::FromString(crt_pem, key_pem));
+	mLoaded.insert_or_assign(std::move(key), certificate);
+	return certificate;
+}
+
+void CertificateProvider::setSettings(CertificateSettings s) {
+	std::lock_guard lock(mMutex);
+	mSettings = std::move(s);
+
+	size_t poolSize = mSettings.poolSize.value_or(0);
+	for (auto &[type, pool] : mPools)
+		while (pool.size() > poolSize)
+			pool.pop_back();
+
+	if (poolSize > 0)
+		refill(CertificateType::Default);
+
+	if (!mSettings.rotationInterval)
+		mShared.clear();
+}
+
+void CertificateProvider::clear() {
+	std::lock_guard lock(mMutex);
+	mPools.clear();
+	mShared.clear();
+}
+
+future_certificate_ptr CertificateProvider::take(CertificateType type) {
+	// mMutex needs to be locked
+
+	auto &pool = mPools[type];
+	if (pool.empty()) {
+		refill(type);
+		return generate_certificate(type);
+	}
+
+	auto certificate = std::move(pool.front());
+	pool.pop_front();
+	refill(type);
+	return certificate;
+}
+
+void CertificateProvider::refill(CertificateType type) {
+	// mMutex needs to be locked
+
+	auto &pool = mPools[type];
+	while (pool.size() < mSettings.poolSize.value_or(0))
+		pool.push_back(generate_certificate(type));
+}
+
 string Certificate::fingerprint() const { return mFingerprint; }
 
 } // namespace rtc::impl
@@ -14,7 +14,11 @@
 #include "init.hpp"
 #include "tls.hpp"
 
+#include <chrono>
+#include <deque>
 #include <future>
+#include <map>
+#include <mutex>
 #include <tuple>
 
 namespace rtc::impl {
@@ -69,6 +73,44 @@ using certificate_ptr = shared_ptr<Certificate>;
 using future_certificate_ptr = std::shared_future<certificate_ptr>;
 
 future_certificate_ptr make_certificate(CertificateType type = CertificateType::Default);
+future_certificate_ptr make_certificate(const Configuration &config);
+
+// Provides local certificates so that connection setup does not need to wait for key generation:
+// certificates may be generated in advance in the background, shared and rotated periodically,
+// or loaded from PEM.
+class CertificateProvider final {
+public:
+	static CertificateProvider &Instance();
+
+	CertificateProvider(const CertificateProvider &) = delete;
+	CertificateProvider &operator=(const CertificateProvider &) = delete;
+	CertificateProvider(CertificateProvider &&) = delete;
+	CertificateProvider &operator=(CertificateProvider &&) = delete;
+
+	future_certificate_ptr get(CertificateType type);
+	certificate_ptr load(const string &crt_pem, const string &key_pem, const string &pass = "");
+
+	void setSettings(CertificateSettings s);
+	void clear(); // release pooled and shared certificates, which hold init tokens
+
+private:
+	CertificateProvider() = default;
+	~CertificateProvider() = default;
+
+	future_certificate_ptr take(CertificateType type);
+	void refill(CertificateType type);
+
+	struct Shared {
+		future_certificate_ptr certificate;
+		std::chrono::steady_clock::time_point createdAt;
+	};
+
+	CertificateSettings mSettings;
+	std::map<CertificateType, std::deque<future_certificate_ptr>> mPools;
+	std::map<CertificateType, Shared> mShared;
+	std::map<std::pair<string, string>, std::weak_ptr<Certificate>> mLoaded; // inline PEM only
+	std::mutex mMutex;
+};
 
 } // namespace rtc::impl
 
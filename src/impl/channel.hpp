@@ -13,6 +13,7 @@
 #include "message.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 
 namespace rtc::impl {
@@ -43,6 +44,10 @@ struct Channel {
 	std::atomic<size_t> bufferedAmount = 0;
 	std::atomic<size_t> bufferedAmountLowThreshold = 0;
 
+	// Arrival time of the last received message, epoch if unknown
+	std::atomic<std::chrono::steady_clock::time_point> lastArrivalTime =
+	    std::chrono::steady_clock::time_point();
+
 private:
 	std::atomic<bool> mOpenTriggered = false;
 };
@@ -96,6 +96,14 @@ void DataChannel::close() {
 	}
 
 	if (!mIsClosed.exchange(true)) {
+		{
+			std::lock_guard flowLock(mRecvFlowMutex);
+			if (transport && mRecvPaused)
+				transport->resumeRecv();
+
+			mRecvPaused = false;
+		}
+
 		if (transport && mStream.has_value())
 			transport->closeStream(mStream.value());
 
@@ -109,7 +117,12 @@ void DataChannel::remoteClose() { close(); }
 
 optional<message_variant> DataChannel::receive() {
 	auto next = mRecvQueue.pop();
-	return next ? std::make_optional(to_variant(std::move(**next))) : nullopt;
+	if (!next)
+		return nullopt;
+
+	lastArrivalTime = (*next)->arrivalTime.value_or(std::chrono::steady_clock::time_point());
+	updateRecvFlowControl();
+	return std::make_optional(to_variant(std::move(**next)));
 }
 
 optional<message_variant> DataChannel::peek() {
@@ -171,27 +184,71 @@ void DataChannel::processOpenMessage(message_ptr) {
 	PLOG_WARNING << "Received an open message for a user-negotiated DataChannel, ignoring";
 }
 
-bool DataChannel::outgoing(message_ptr message) {
-	shared_ptr<SctpTransport> transport;
-	{
-		std::shared_lock lock(mMutex);
-		transport = mSctpTransport.lock();
+DataChannel::OutgoingParams DataChannel::getOutgoingParams(size_t size) const {
+	std::shared_lock lock(mMutex);
+	auto transport = mSctpTransport.lock();
+
+	if (!transport || mIsClosed)
+		throw std::runtime_error("DataChannel is closed");
 
-		if (!transport || mIsClosed)
-			throw std::runtime_error("DataChannel is closed");
+	if (!mStream.has_value())
+		throw std::logic_error("DataChannel has no stream assigned");
 
-		if (!mStream.has_value())
-			throw std::logic_error("DataChannel has no stream assigned");
+	if (size > maxMessageSize())
+		throw std::invalid_argument("Message size exceeds limit");
 
-		if (message->size() > maxMessageSize())
-			throw std::invalid_argument("Message size exceeds limit");
+	// Before the ACK has been received on a DataChannel, all messages must be sent ordered
+	return {std::move(transport), mStream.value(), mIsOpen ? mReliability : nullptr};
+}
 
-		// Before the ACK has been received on a DataChannel, all messages must be sent ordered
-		message->reliability = mIsOpen ? mReliability : nullptr;
-		message->stream = mStream.value();
-	}
+bool DataChannel::outgoing(message_ptr message) {
+	auto params = getOutgoingParams(message->size());
+	message->reliability = std::move(params.reliability);
+	message->stream = params.stream;
+	return params.transport->send(message);
+}
+
+size_t DataChannel::Broadcast(const std::vector<shared_ptr<DataChannel>> &channels,
+                              message_ptr message) {
+	// A message is never modified once handed to the SCTP transport, so the same message can be
+	// queued on any number of transports. It only needs to be copied when the stream id or the
+	// reliability differs, which is bounded by the number of distinct channel configurations.
+	auto sameReliability = [](const shared_ptr<Reliability> &a, const shared_ptr<Reliability> &b) {
+		if (!a || !b)
+			return a == b;
+
+		return a->type == b->type && a->unordered == b->unordered && a->rexmit == b->rexmit &&
+		       a->latestOnly == b->latestOnly;
+	};
+
+	std::vector<message_ptr> messages;
+	size_t count = 0;
+	for (const auto &channel : channels) {
+		try {
+			auto params = channel->getOutgoingParams(message->size());
+			auto it = std::find_if(messages.begin(), messages.end(), [&](const message_ptr &m) {
+				return m->stream == params.stream &&
+				       sameReliability(m->reliability, params.reliability);
+			});
+
+			message_ptr shared;
+			if (it != messages.end()) {
+				shared = *it;
+			} else {
+				shared = messages.empty() ? message : std::make_shared<Message>(*message);
+				shared->stream = params.stream;
+				shared->reliability = std::move(params.reliability);
+				messages.push_back(shared);
+			}
 
-	return transport->send(message);
+			params.transport->send(std::move(shared));
+			++count;
+
+		} catch (const std::exception &e) {
+			PLOG_WARNING << "DataChannel broadcast: " << e.what();
+		}
+	}
+	return count;
 }
 
 void DataChannel::incoming(message_ptr message) {
@@ -224,6 +281,7 @@ void DataChannel::incoming(message_ptr message) {
 	case Message::String:
 	case Message::Binary:
 		mRecvQueue.push(message);
+		updateRecvFlowControl();
 		triggerAvailable(mRecvQueue.size());
 		break;
 	default:
@@ -232,6 +290,36 @@ void DataChannel::incoming(message_ptr message) {
 	}
 }
 
+void DataChannel::updateRecvFlowControl() {
+	// If the application does not keep up, stop reading from the SCTP transport instead of growing
+	// the queue, so the receiver window closes and the remote sender is throttled.
+	// The amount is read under the lock so the last caller always sees the latest amount,
+	// otherwise reception could be paused after the queue was drained and never resumed.
+	std::lock_guard flowLock(mRecvFlowMutex);
+	const size_t amount = mRecvQueue.amount();
+	if (amount >= RECV_QUEUE_HIGH_THRESHOLD && !mIsClosed) {
+		if (mRecvPaused)
+			return;
+
+		std::shared_lock lock(mMutex);
+		if (auto transport = mSctpTransport.lock()) {
+			PLOG_DEBUG << "DataChannel receive queue is full, pausing reception";
+			transport->pauseRecv();
+			mRecvPaused = true;
+		}
+
+	} else if (amount <= RECV_QUEUE_LOW_THRESHOLD) {
+		if (!mRecvPaused)
+			return;
+
+		PLOG_DEBUG << "DataChannel receive queue is drained, resuming reception";
+		mRecvPaused = false;
+		std::shared_lock lock(mMutex);
+		if (auto transport = mSctpTransport.lock())
+			transport->resumeRecv();
+	}
+}
+
 OutgoingDataChannel::OutgoingDataChannel(weak_ptr<PeerConnection> pc, string label, string protocol,
                                          Reliability reliability)
     : DataChannel(pc, std::move(label), std::move(protocol), std::move(reliability)) {}
@@ -18,7 +18,9 @@
 #include "sctptransport.hpp"
 
 #include <atomic>
+#include <mutex>
 #include <shared_mutex>
+#include <vector>
 
 namespace rtc::impl {
 
@@ -26,6 +28,8 @@ struct PeerConnection;
 
 struct DataChannel : Channel, std::enable_shared_from_this<DataChannel> {
 	static bool IsOpenMessage(message_ptr message);
+	static size_t Broadcast(const std::vector<shared_ptr<DataChannel>> &channels,
+	                        message_ptr message);
 
 	DataChannel(weak_ptr<PeerConnection> pc, string label, string protocol,
 	            Reliability reliability);
@@ -68,7 +72,18 @@ protected:
 	std::atomic<bool> mIsClosed = false;
 
 private:
+	struct OutgoingParams {
+		shared_ptr<SctpTransport> transport;
+		uint16_t stream;
+		shared_ptr<Reliability> reliability;
+	};
+
+	OutgoingParams getOutgoingParams(size_t size) const;
+	void updateRecvFlowControl();
+
 	Queue<message_ptr> mRecvQueue;
+	bool mRecvPaused = false; // under mRecvFlowMutex
+	std::mutex mRecvFlowMutex;
 };
 
 struct OutgoingDataChannel final : public DataChannel {
@@ -70,21 +70,20 @@ DtlsSrtpTransport::DtlsSrtpTransport(shared_ptr<IceTransport> lower,
 	if (srtp_err_status_t err = srtp_create(&mSrtpIn, nullptr)) {
 		throw std::runtime_error("srtp_create failed, status=" + to_string(static_cast<int>(err)));
 	}
-	if (srtp_err_status_t err = srtp_create(&mSrtpOut, nullptr)) {
-		srtp_dealloc(mSrtpIn);
-		throw std::runtime_error("srtp_create failed, status=" + to_string(static_cast<int>(err)));
-	}
 }
 
 DtlsSrtpTransport::~DtlsSrtpTransport() {
 	stop(); // stop before deallocating
 
 	srtp_dealloc(mSrtpIn);
-	srtp_dealloc(mSrtpOut);
+}
+
+DtlsSrtpTransport::OutboundSession::~OutboundSession() {
+	if (srtp)
+		srtp_dealloc(srtp);
 }
 
 bool DtlsSrtpTransport::sendMedia(message_ptr message) {
-	std::lock_guard lock(sendMutex);
 	if (!message)
 		return false;
 
@@ -93,20 +92,103 @@ bool DtlsSrtpTransport::sendMedia(message_ptr message) {
 		return false;
 	}
 
-	int size = int(message->size());
-	PLOG_VERBOSE << "Send size=" << size;
+	auto session = getOutboundSession(message);
+	std::lock_guard lock(session->mutex);
+	protectMedia(session->srtp, message);
+	return Transport::outgoing(message); // sent directly, not as a DTLS record
+}
+
+size_t DtlsSrtpTransport::sendMedia(const message_vector &messages) {
+	if (!mInitDone) {
+		PLOG_ERROR << "SRTP media sent before keys are derived";
+		return 0;
+	}
+
+	// Consecutive packets for the same SSRC are protected under a single lock, then passed down as
+	// one batch before the lock is released so packets can't be reordered on the wire
+	shared_ptr<OutboundSession> session;
+	std::unique_lock<std::mutex> lock;
+	message_vector run;
+	run.reserve(messages.size());
+	size_t count = 0;
+	for (const auto &message : messages) {
+		if (!message)
+			continue;
+
+		try {
+			auto next = getOutboundSession(message);
+			if (next != session) {
+				if (!run.empty()) {
+					count += outgoingBatch(run);
+					run.clear();
+				}
+
+				if (lock.owns_lock())
+					lock.unlock(); // never hold two session locks at once
+
+				session = std::move(next);
+				lock = std::unique_lock(session->mutex);
+			}
+
+			protectMedia(session->srtp, message);
+			run.push_back(message);
+
+		} catch (const std::exception &e) {
+			PLOG_WARNING << e.what();
+			continue;
+		}
+	}
 
+	if (!run.empty())
+		count += outgoingBatch(run);
+
+	return count;
+}
+
+shared_ptr<DtlsSrtpTransport::OutboundSession>
+DtlsSrtpTransport::getOutboundSession(const message_ptr &message) {
 	// The RTP header has a minimum size of 12 bytes
 	// An RTCP packet can have a minimum size of 8 bytes
-	if (size < 8)
+	bool isRtcp = message->size() >= 8 && IsRtcp(*message);
+	if (message->size() < (isRtcp ? 8 : 12))
 		throw std::runtime_error("RTP/RTCP packet too short");
 
+	uint32_t ssrc = isRtcp ? reinterpret_cast<const RtcpSr *>(message->data())->senderSSRC()
+	                       : reinterpret_cast<const RtpHeader *>(message->data())->ssrc();
+
+	{
+		std::shared_lock lock(mOutboundMutex);
+		if (auto it = mOutboundSessions.find(ssrc); it != mOutboundSessions.end())
+			return it->second;
+	}
+
+	std::unique_lock lock(mOutboundMutex);
+	auto &session = mOutboundSessions[ssrc];
+	if (!session) {
+		PLOG_DEBUG << "Creating outbound SRTP session for SSRC " << ssrc;
+		auto created = std::make_shared<OutboundSession>();
+		if (srtp_err_status_t err = srtp_create(&created->srtp, &mOutboundPolicy)) {
+			mOutboundSessions.erase(ssrc);
+			throw std::runtime_error("srtp_create failed, status=" +
+			                         to_string(static_cast<int>(err)));
+		}
+		session = std::move(created);
+	}
+	return session;
+}
+
+void DtlsSrtpTransport::protectMedia(srtp_t srtp, message_ptr message) {
+	// The session mutex needs to be locked
+
+	int size = int(message->size());
+	PLOG_VERBOSE << "Send size=" << size;
+
 	// srtp_protect() and srtp_protect_rtcp() assume that they can write SRTP_MAX_TRAILER_LEN (for
 	// the authentication tag) into the location in memory immediately following the RTP packet.
 	message->resize(size + SRTP_MAX_TRAILER_LEN);
 
 	if (IsRtcp(*message)) { // Demultiplex RTCP and RTP using payload type
-		if (srtp_err_status_t err = srtp_protect_rtcp(mSrtpOut, message->data(), &size)) {
+		if (srtp_err_status_t err = srtp_protect_rtcp(srtp, message->data(), &size)) {
 			if (err == srtp_err_status_replay_fail)
 				throw std::runtime_error("Outgoing SRTCP packet is a replay");
 			else
@@ -116,7 +198,7 @@ bool DtlsSrtpTransport::sendMedia(message_ptr message) {
 		PLOG_VERBOSE << "Protected SRTCP packet, size=" << size;
 
 	} else {
-		if (srtp_err_status_t err = srtp_protect(mSrtpOut, message->data(), &size)) {
+		if (srtp_err_status_t err = srtp_protect(srtp, message->data(), &size)) {
 			if (err == srtp_err_status_replay_fail)
 				throw std::runtime_error("Outgoing SRTP packet is a replay");
 			else
@@ -133,8 +215,6 @@ bool DtlsSrtpTransport::sendMedia(message_ptr message) {
 		// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
 		message->dscp = 36; // AF42: Assured Forwarding class 4, medium drop probability
 	}
-
-	return Transport::outgoing(message); // bypass DTLS DSCP marking
 }
 
 void DtlsSrtpTransport::recvMedia(message_ptr message) {
@@ -352,7 +432,8 @@ void DtlsSrtpTransport::postHandshake() {
 		throw std::runtime_error("SRTP add inbound stream failed, status=" +
 		                         to_string(static_cast<int>(err)));
 
-	srtp_policy_t outbound = {};
+	// Outbound sessions are created for each SSRC from this policy
+	srtp_policy_t &outbound = mOutboundPolicy;
 	if (srtp_crypto_policy_set_from_profile_for_rtp(&outbound.rtp, srtpProfile))
 		throw std::runtime_error("SRTP profile is not supported");
 	if (srtp_crypto_policy_set_from_profile_for_rtcp(&outbound.rtcp, srtpProfile))
@@ -364,10 +445,6 @@ void DtlsSrtpTransport::postHandshake() {
 	outbound.allow_repeat_tx = true;
 	outbound.next = nullptr;
 
-	if (srtp_err_status_t err = srtp_add_stream(mSrtpOut, &outbound))
-		throw std::runtime_error("SRTP add outbound stream failed, status=" +
-		                         to_string(static_cast<int>(err)));
-
 	mInitDone = true;
 }
 
@@ -21,6 +21,8 @@
 #endif
 
 #include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace rtc::impl {
 
@@ -36,8 +38,19 @@ public:
 	~DtlsSrtpTransport();
 
 	bool sendMedia(message_ptr message);
+	size_t sendMedia(const message_vector &messages); // returns the number of messages sent
 
 private:
+	// Outgoing packets are protected with a distinct session per SSRC, created from the same
+	// keying material, so that different tracks can be protected concurrently
+	struct OutboundSession {
+		srtp_t srtp = nullptr;
+		std::mutex mutex;
+		~OutboundSession();
+	};
+
+	shared_ptr<OutboundSession> getOutboundSession(const message_ptr &message);
+	void protectMedia(srtp_t srtp, message_ptr message);
 	void recvMedia(message_ptr message);
 	bool demuxMessage(message_ptr message) override;
 	void postHandshake() override;
@@ -53,11 +66,13 @@ private:
 #endif
 
 	message_callback mSrtpRecvCallback;
-	srtp_t mSrtpIn, mSrtpOut;
+	srtp_t mSrtpIn;
+	srtp_policy_t mOutboundPolicy = {};
+	std::unordered_map<uint32_t, shared_ptr<OutboundSession>> mOutboundSessions;
+	std::shared_mutex mOutboundMutex;
 	std::atomic<bool> mInitDone = false;
 	std::vector<unsigned char> mClientSessionKey;
 	std::vector<unsigned char> mServerSessionKey;
-	std::mutex sendMutex;
 };
 
 } // namespace rtc::impl
@@ -11,6 +11,7 @@
 #include "icetransport.hpp"
 #include "internals.hpp"
 #include "threadpool.hpp"
+#include "utils.hpp"
 
 #include <algorithm>
 #include <chrono>
@@ -39,6 +40,13 @@ void DtlsTransport::enqueueRecv() {
 	}
 }
 
+bool DtlsTransport::outgoingRecord(const byte *data, size_t size) {
+	// Records are passed down to the ICE transport without being copied into a message
+	bool result = outgoingBuffer(data, size, mCurrentDscp);
+	mOutgoingResult = result;
+	return result;
+}
+
 #if USE_GNUTLS
 
 void DtlsTransport::Init() {
@@ -130,16 +138,23 @@ void DtlsTransport::stop() {
 }
 
 bool DtlsTransport::send(message_ptr message) {
-	if (!message || state() != State::Connected)
+	if (!message)
 		return false;
 
-	PLOG_VERBOSE << "Send size=" << message->size();
+	return sendBuffer(message->data(), message->size(), message->dscp);
+}
+
+bool DtlsTransport::sendBuffer(const byte *data, size_t size, unsigned int dscp) {
+	if (state() != State::Connected)
+		return false;
+
+	PLOG_VERBOSE << "Send size=" << size;
 
 	ssize_t ret;
 	do {
 		std::lock_guard lock(mSendMutex);
-		mCurrentDscp = message->dscp;
-		ret = gnutls_record_send(mSession, message->data(), message->size());
+		mCurrentDscp = dscp;
+		ret = gnutls_record_send(mSession, data, size);
 	} while (ret == GNUTLS_E_INTERRUPTED || ret == GNUTLS_E_AGAIN);
 
 	if (ret == GNUTLS_E_LARGE_PACKET)
@@ -162,14 +177,6 @@ void DtlsTransport::incoming(message_ptr message) {
 	enqueueRecv();
 }
 
-bool DtlsTransport::outgoing(message_ptr message) {
-	message->dscp = mCurrentDscp;
-
-	bool result = Transport::outgoing(std::move(message));
-	mOutgoingResult = result;
-	return result;
-}
-
 bool DtlsTransport::demuxMessage(message_ptr) {
 	// Dummy
 	return false;
@@ -187,9 +194,6 @@ void DtlsTransport::doRecv() {
 		return;
 
 	try {
-		const size_t bufferSize = 4096;
-		char buffer[bufferSize];
-
 		// Handle handshake if connecting
 		if (state() == State::Connecting) {
 			int ret;
@@ -214,7 +218,7 @@ void DtlsTransport::doRecv() {
 
 			// RFC 8261: DTLS MUST support sending messages larger than the current path MTU
 			// See https://www.rfc-editor.org/rfc/rfc8261.html#section-5
-			gnutls_dtls_set_mtu(mSession, bufferSize + 1);
+			gnutls_dtls_set_mtu(mSession, DTLS_MTU_AFTER_HANDSHAKE);
 
 			PLOG_INFO << "DTLS handshake finished";
 			changeState(State::Connected);
@@ -222,8 +226,12 @@ void DtlsTransport::doRecv() {
 		}
 
 		if (state() == State::Connected) {
+			// The datagram is only pulled during the call, so records are read into a buffer
+			// reused across calls and copied out at their actual size
+			mRecordBuffer.resize(DTLS_MAX_RECORD_SIZE);
 			while (true) {
-				ssize_t ret = gnutls_record_recv(mSession, buffer, bufferSize);
+				ssize_t ret =
+				    gnutls_record_recv(mSession, mRecordBuffer.data(), mRecordBuffer.size());
 
 				if (ret == GNUTLS_E_AGAIN) {
 					return;
@@ -253,8 +261,9 @@ void DtlsTransport::doRecv() {
 						PLOG_DEBUG << "DTLS connection cleanly closed";
 						break;
 					}
-					auto *b = reinterpret_cast<byte *>(buffer);
-					recv(make_message(b, b + ret));
+					auto record = make_message(mRecordBuffer.begin(), mRecordBuffer.begin() + ret);
+					record->arrivalTime = mLastArrivalTime;
+					recv(std::move(record));
 				}
 			}
 		}
@@ -312,7 +321,7 @@ ssize_t DtlsTransport::WriteCallback(gnutls_transport_ptr_t ptr, const void *dat
 	try {
 		if (len > 0) {
 			auto b = reinterpret_cast<const byte *>(data);
-			t->outgoing(make_message(b, b + len));
+			t->outgoingRecord(b, len);
 		}
 		gnutls_transport_set_errno(t->mSession, 0);
 		return ssize_t(len);
@@ -338,6 +347,8 @@ ssize_t DtlsTransport::ReadCallback(gnutls_transport_ptr_t ptr, void *data, size
 			if (t->demuxMessage(message))
 				continue;
 
+			t->mLastArrivalTime = message->arrivalTime;
+
 			ssize_t len = std::min(maxlen, message->size());
 			std::memcpy(data, message->data(), len);
 			gnutls_transport_set_errno(t->mSession, 0);
@@ -373,6 +384,34 @@ const mbedtls_ssl_srtp_profile srtpSupportedProtectionProfiles[] = {
     MBEDTLS_TLS_SRTP_UNSET,
 };
 
+TlsContextCache<mbedtls_ssl_config> DtlsTransport::ConfigCache;
+
+shared_ptr<mbedtls_ssl_config> DtlsTransport::CreateConfig(certificate_ptr certificate,
+                                                           bool isClient) {
+	auto conf = mbedtls::new_ssl_config(isClient ? MBEDTLS_SSL_IS_CLIENT : MBEDTLS_SSL_IS_SERVER,
+	                                    MBEDTLS_SSL_TRANSPORT_DATAGRAM);
+
+	// The certificate is verified by the per-context callback
+	mbedtls_ssl_conf_authmode(conf.get(), MBEDTLS_SSL_VERIFY_OPTIONAL);
+
+	auto [crt, pk] = certificate->credentials();
+	mbedtls::check(mbedtls_ssl_conf_own_cert(conf.get(), crt.get(), pk.get()),
+	               "Failed creating Mbed TLS Context");
+
+	mbedtls_ssl_conf_dtls_cookies(conf.get(), NULL, NULL, NULL);
+	mbedtls_ssl_conf_dtls_srtp_protection_profiles(conf.get(), srtpSupportedProtectionProfiles);
+
+#ifdef MBEDTLS_SSL_DTLS_CONNECTION_ID
+	// RFC 9146: Connection IDs allow the session to continue if the peer address changes
+	// See https://www.rfc-editor.org/rfc/rfc9146.html
+	mbedtls::check(mbedtls_ssl_conf_cid(conf.get(), DTLS_CONNECTION_ID_SIZE,
+	                                    MBEDTLS_SSL_UNEXPECTED_CID_IGNORE),
+	               "Failed setting DTLS Connection ID length");
+#endif
+
+	return conf;
+}
+
 DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr certificate,
                              optional<size_t> mtu, verifier_callback verifierCallback,
                              state_callback stateChangeCallback)
@@ -385,44 +424,31 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 	if (!mCertificate)
 		throw std::invalid_argument("DTLS certificate is null");
 
-	mbedtls_entropy_init(&mEntropy);
-	mbedtls_ctr_drbg_init(&mDrbg);
 	mbedtls_ssl_init(&mSsl);
-	mbedtls_ssl_config_init(&mConf);
-	mbedtls_ctr_drbg_set_prediction_resistance(&mDrbg, MBEDTLS_CTR_DRBG_PR_ON);
 
 	try {
-		mbedtls::check(mbedtls_ctr_drbg_seed(&mDrbg, mbedtls_entropy_func, &mEntropy, NULL, 0),
-		               "Failed creating Mbed TLS Context");
-
-		mbedtls::check(mbedtls_ssl_config_defaults(
-		                   &mConf, mIsClient ? MBEDTLS_SSL_IS_CLIENT : MBEDTLS_SSL_IS_SERVER,
-		                   MBEDTLS_SSL_TRANSPORT_DATAGRAM, MBEDTLS_SSL_PRESET_DEFAULT),
-		               "Failed creating Mbed TLS Context");
-
-		mbedtls_ssl_conf_authmode(&mConf, MBEDTLS_SSL_VERIFY_OPTIONAL);
-		mbedtls_ssl_conf_verify(&mConf, DtlsTransport::CertificateCallback, this);
-
-		mbedtls_ssl_conf_rng(&mConf, mbedtls_ctr_drbg_random, &mDrbg);
-
-		auto [crt, pk] = mCertificate->credentials();
-		mbedtls::check(mbedtls_ssl_conf_own_cert(&mConf, crt.get(), pk.get()),
-		               "Failed creating Mbed TLS Context");
-
-		mbedtls_ssl_conf_dtls_cookies(&mConf, NULL, NULL, NULL);
-		mbedtls_ssl_conf_dtls_srtp_protection_profiles(&mConf, srtpSupportedProtectionProfiles);
+		// The configuration is shared between transports using the same certificate and role
+		mConf = ConfigCache.get(mCertificate, mIsClient, [this]() {
+			return CreateConfig(mCertificate, mIsClient);
+		});
 
-		mbedtls::check(mbedtls_ssl_setup(&mSsl, &mConf), "Failed creating Mbed TLS Context");
+		mbedtls::check(mbedtls_ssl_setup(&mSsl, mConf.get()), "Failed creating Mbed TLS Context");
 
+		mbedtls_ssl_set_verify(&mSsl, DtlsTransport::CertificateCallback, this);
 		mbedtls_ssl_set_export_keys_cb(&mSsl, DtlsTransport::ExportKeysCallback, this);
 		mbedtls_ssl_set_bio(&mSsl, this, WriteCallback, ReadCallback, NULL);
 		mbedtls_ssl_set_timer_cb(&mSsl, this, SetTimerCallback, GetTimerCallback);
 
+#ifdef MBEDTLS_SSL_DTLS_CONNECTION_ID
+		// The Connection ID only needs to be unique for the peer, it is not a secret
+		unsigned char cid[DTLS_CONNECTION_ID_SIZE];
+		std::generate(cid, cid + DTLS_CONNECTION_ID_SIZE, utils::random_bytes_engine());
+		mbedtls::check(mbedtls_ssl_set_cid(&mSsl, MBEDTLS_SSL_CID_ENABLED, cid, sizeof(cid)),
+		               "Failed setting DTLS Connection ID");
+#endif
+
 	} catch (...) {
-		mbedtls_entropy_free(&mEntropy);
-		mbedtls_ctr_drbg_free(&mDrbg);
 		mbedtls_ssl_free(&mSsl);
-		mbedtls_ssl_config_free(&mConf);
 		throw;
 	}
 
@@ -435,19 +461,14 @@ DtlsTransport::~DtlsTransport() {
 	stop();
 
 	PLOG_DEBUG << "Destroying DTLS transport";
-	mbedtls_entropy_free(&mEntropy);
-	mbedtls_ctr_drbg_free(&mDrbg);
 	mbedtls_ssl_free(&mSsl);
-	mbedtls_ssl_config_free(&mConf);
 }
 
 void DtlsTransport::Init() {
 	// Nothing to do
 }
 
-void DtlsTransport::Cleanup() {
-	// Nothing to do
-}
+void DtlsTransport::Cleanup() { ConfigCache.clear(); }
 
 void DtlsTransport::start() {
 	PLOG_DEBUG << "Starting DTLS transport";
@@ -472,20 +493,26 @@ void DtlsTransport::stop() {
 }
 
 bool DtlsTransport::send(message_ptr message) {
-	if (!message || state() != State::Connected)
+	if (!message)
+		return false;
+
+	return sendBuffer(message->data(), message->size(), message->dscp);
+}
+
+bool DtlsTransport::sendBuffer(const byte *data, size_t size, unsigned int dscp) {
+	if (state() != State::Connected)
 		return false;
 
-	PLOG_VERBOSE << "Send size=" << message->size();
+	PLOG_VERBOSE << "Send size=" << size;
 
 	int ret;
 	do {
 		std::lock_guard lock(mSslMutex);
-		if (message->size() > size_t(mbedtls_ssl_get_max_out_record_payload(&mSsl)))
+		if (size > size_t(mbedtls_ssl_get_max_out_record_payload(&mSsl)))
 			return false;
 
-		mCurrentDscp = message->dscp;
-		ret = mbedtls_ssl_write(&mSsl, reinterpret_cast<const unsigned char *>(message->data()),
-		                        message->size());
+		mCurrentDscp = dscp;
+		ret = mbedtls_ssl_write(&mSsl, reinterpret_cast<const unsigned char *>(data), size);
 	} while (!mbedtls::check(ret));
 
 	return mOutgoingResult;
@@ -502,14 +529,6 @@ void DtlsTransport::incoming(message_ptr message) {
 	enqueueRecv();
 }
 
-bool DtlsTransport::outgoing(message_ptr message) {
-	message->dscp = mCurrentDscp;
-
-	bool result = Transport::outgoing(std::move(message));
-	mOutgoingResult = result;
-	return result;
-}
-
 bool DtlsTransport::demuxMessage(message_ptr) {
 	// Dummy
 	return false;
@@ -519,6 +538,22 @@ void DtlsTransport::postHandshake() {
 	// Dummy
 }
 
+void DtlsTransport::logConnectionId() {
+#ifdef MBEDTLS_SSL_DTLS_CONNECTION_ID
+	int enabled = MBEDTLS_SSL_CID_DISABLED;
+	{
+		std::lock_guard lock(mSslMutex);
+		if (mbedtls_ssl_get_peer_cid(&mSsl, &enabled, NULL, NULL) != 0)
+			return;
+	}
+
+	if (enabled == MBEDTLS_SSL_CID_ENABLED)
+		PLOG_DEBUG << "DTLS Connection ID negotiated";
+	else
+		PLOG_DEBUG << "DTLS Connection ID not supported by remote peer";
+#endif
+}
+
 void DtlsTransport::doRecv() {
 	std::lock_guard lock(mRecvMutex);
 	--mPendingRecvCount;
@@ -527,9 +562,6 @@ void DtlsTransport::doRecv() {
 		return;
 
 	try {
-		const size_t bufferSize = 4096;
-		char buffer[bufferSize];
-
 		// Handle handshake if connecting
 		if (state() == State::Connecting) {
 			while (true) {
@@ -553,10 +585,12 @@ void DtlsTransport::doRecv() {
 					// See https://www.rfc-editor.org/rfc/rfc8261.html#section-5
 					{
 						std::lock_guard lock(mSslMutex);
-						mbedtls_ssl_set_mtu(&mSsl, static_cast<unsigned int>(bufferSize + 1));
+						mbedtls_ssl_set_mtu(&mSsl,
+						                    static_cast<unsigned int>(DTLS_MTU_AFTER_HANDSHAKE));
 					}
 
 					PLOG_INFO << "DTLS handshake finished";
+					logConnectionId();
 					changeState(State::Connected);
 					postHandshake();
 					break;
@@ -565,12 +599,16 @@ void DtlsTransport::doRecv() {
 		}
 
 		if (state() == State::Connected) {
+			// The datagram is only pulled during the call, so records are read into a buffer
+			// reused across calls and copied out at their actual size
+			mRecordBuffer.resize(DTLS_MAX_RECORD_SIZE);
 			while (true) {
 				int ret;
 				{
 					std::lock_guard lock(mSslMutex);
-					ret = mbedtls_ssl_read(&mSsl, reinterpret_cast<unsigned char *>(buffer),
-					                       bufferSize);
+					ret = mbedtls_ssl_read(&mSsl,
+					                       reinterpret_cast<unsigned char *>(mRecordBuffer.data()),
+					                       mRecordBuffer.size());
 				}
 
 				if (ret == MBEDTLS_ERR_SSL_WANT_READ) {
@@ -587,8 +625,9 @@ void DtlsTransport::doRecv() {
 						PLOG_DEBUG << "DTLS connection terminated";
 						break;
 					}
-					auto *b = reinterpret_cast<byte *>(buffer);
-					recv(make_message(b, b + ret));
+					auto record = make_message(mRecordBuffer.begin(), mRecordBuffer.begin() + ret);
+					record->arrivalTime = mLastArrivalTime;
+					recv(std::move(record));
 				}
 			}
 		}
@@ -632,7 +671,7 @@ int DtlsTransport::WriteCallback(void *ctx, const unsigned char *buf, size_t len
 	try {
 		if (len > 0) {
 			auto b = reinterpret_cast<const byte *>(buf);
-			t->outgoing(make_message(b, b + len));
+			t->outgoingRecord(b, len);
 		}
 		return int(len);
 
@@ -655,6 +694,8 @@ int DtlsTransport::ReadCallback(void *ctx, unsigned char *buf, size_t len) {
 			if (t->demuxMessage(message))
 				continue;
 
+			t->mLastArrivalTime = message->arrivalTime;
+
 			auto bufMin = std::min(len, size_t(message->size()));
 			std::memcpy(buf, message->data(), bufMin);
 			return int(len);
@@ -700,6 +741,7 @@ int DtlsTransport::GetTimerCallback(void *ctx) {
 BIO_METHOD *DtlsTransport::BioMethods = NULL;
 int DtlsTransport::TransportExIndex = -1;
 std::mutex DtlsTransport::GlobalMutex;
+TlsContextCache<SSL_CTX> DtlsTransport::ContextCache;
 
 void DtlsTransport::Init() {
 	std::lock_guard lock(GlobalMutex);
@@ -720,8 +762,53 @@ void DtlsTransport::Init() {
 	}
 }
 
-void DtlsTransport::Cleanup() {
-	// Nothing to do
+void DtlsTransport::Cleanup() { ContextCache.clear(); }
+
+shared_ptr<SSL_CTX> DtlsTransport::CreateContext(certificate_ptr certificate) {
+	auto ctx = shared_ptr<SSL_CTX>(SSL_CTX_new(DTLS_method()), SSL_CTX_free);
+	if (!ctx)
+		throw std::runtime_error("Failed to create SSL context");
+
+	// RFC 8261: SCTP performs segmentation and reassembly based on the path MTU.
+	// Therefore, the DTLS layer MUST NOT use any compression algorithm.
+	// See https://www.rfc-editor.org/rfc/rfc8261.html#section-5
+	// RFC 8827: Implementations MUST NOT implement DTLS renegotiation
+	// See https://www.rfc-editor.org/rfc/rfc8827.html#section-6.5
+	SSL_CTX_set_options(ctx.get(), SSL_OP_NO_SSLv3 | SSL_OP_NO_COMPRESSION | SSL_OP_NO_QUERY_MTU |
+	                                   SSL_OP_NO_RENEGOTIATION);
+
+	// The context is shared between peers, so session resumption must stay disabled as it would
+	// skip the fingerprint verification of the remote certificate
+	SSL_CTX_set_options(ctx.get(), SSL_OP_NO_TICKET);
+	SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_OFF);
+
+	SSL_CTX_set_min_proto_version(ctx.get(), DTLS1_VERSION);
+	SSL_CTX_set_read_ahead(ctx.get(), 1);
+	SSL_CTX_set_quiet_shutdown(ctx.get(), 0); // send the close_notify alert
+	SSL_CTX_set_info_callback(ctx.get(), InfoCallback);
+
+	SSL_CTX_set_verify(ctx.get(), SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+	                   CertificateCallback);
+	SSL_CTX_set_verify_depth(ctx.get(), 1);
+
+	openssl::check(SSL_CTX_set_cipher_list(ctx.get(), "ALL:!LOW:!EXP:!RC4:!MD5:@STRENGTH"),
+	               "Failed to set SSL priorities");
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000
+	openssl::check(SSL_CTX_set1_groups_list(ctx.get(), "P-256"), "Failed to set SSL groups");
+#else
+	auto ecdh = unique_ptr<EC_KEY, decltype(&EC_KEY_free)>(
+	    EC_KEY_new_by_curve_name(NID_X9_62_prime256v1), EC_KEY_free);
+	SSL_CTX_set_tmp_ecdh(ctx.get(), ecdh.get());
+	SSL_CTX_set_options(ctx.get(), SSL_OP_SINGLE_ECDH_USE);
+#endif
+
+	auto [x509, pkey] = certificate->credentials();
+	SSL_CTX_use_certificate(ctx.get(), x509);
+	SSL_CTX_use_PrivateKey(ctx.get(), pkey);
+	openssl::check(SSL_CTX_check_private_key(ctx.get()), "SSL local private key check failed");
+
+	return ctx;
 }
 
 DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr certificate,
@@ -736,45 +823,11 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 		throw std::invalid_argument("DTLS certificate is null");
 
 	try {
-		mCtx = SSL_CTX_new(DTLS_method());
-		if (!mCtx)
-			throw std::runtime_error("Failed to create SSL context");
-
-		// RFC 8261: SCTP performs segmentation and reassembly based on the path MTU.
-		// Therefore, the DTLS layer MUST NOT use any compression algorithm.
-		// See https://www.rfc-editor.org/rfc/rfc8261.html#section-5
-		// RFC 8827: Implementations MUST NOT implement DTLS renegotiation
-		// See https://www.rfc-editor.org/rfc/rfc8827.html#section-6.5
-		SSL_CTX_set_options(mCtx, SSL_OP_NO_SSLv3 | SSL_OP_NO_COMPRESSION | SSL_OP_NO_QUERY_MTU |
-		                              SSL_OP_NO_RENEGOTIATION);
-
-		SSL_CTX_set_min_proto_version(mCtx, DTLS1_VERSION);
-		SSL_CTX_set_read_ahead(mCtx, 1);
-		SSL_CTX_set_quiet_shutdown(mCtx, 0); // send the close_notify alert
-		SSL_CTX_set_info_callback(mCtx, InfoCallback);
-
-		SSL_CTX_set_verify(mCtx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
-		                   CertificateCallback);
-		SSL_CTX_set_verify_depth(mCtx, 1);
-
-		openssl::check(SSL_CTX_set_cipher_list(mCtx, "ALL:!LOW:!EXP:!RC4:!MD5:@STRENGTH"),
-		               "Failed to set SSL priorities");
-
-#if OPENSSL_VERSION_NUMBER >= 0x30000000
-		openssl::check(SSL_CTX_set1_groups_list(mCtx, "P-256"), "Failed to set SSL groups");
-#else
-		auto ecdh = unique_ptr<EC_KEY, decltype(&EC_KEY_free)>(
-		    EC_KEY_new_by_curve_name(NID_X9_62_prime256v1), EC_KEY_free);
-		SSL_CTX_set_tmp_ecdh(mCtx, ecdh.get());
-		SSL_CTX_set_options(mCtx, SSL_OP_SINGLE_ECDH_USE);
-#endif
-
-		auto [x509, pkey] = mCertificate->credentials();
-		SSL_CTX_use_certificate(mCtx, x509);
-		SSL_CTX_use_PrivateKey(mCtx, pkey);
-		openssl::check(SSL_CTX_check_private_key(mCtx), "SSL local private key check failed");
+		// The context is shared between transports using the same certificate and role
+		mCtx = ContextCache.get(mCertificate, mIsClient,
+		                        [this]() { return CreateContext(mCertificate); });
 
-		mSsl = SSL_new(mCtx);
+		mSsl = SSL_new(mCtx.get());
 		if (!mSsl)
 			throw std::runtime_error("Failed to create SSL instance");
 
@@ -815,8 +868,6 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 	} catch (...) {
 		if (mSsl)
 			SSL_free(mSsl);
-		if (mCtx)
-			SSL_CTX_free(mCtx);
 		throw;
 	}
 
@@ -830,7 +881,6 @@ DtlsTransport::~DtlsTransport() {
 
 	PLOG_DEBUG << "Destroying DTLS transport";
 	SSL_free(mSsl);
-	SSL_CTX_free(mCtx);
 }
 
 void DtlsTransport::start() {
@@ -864,16 +914,23 @@ void DtlsTransport::stop() {
 }
 
 bool DtlsTransport::send(message_ptr message) {
-	if (!message || state() != State::Connected)
+	if (!message)
 		return false;
 
-	PLOG_VERBOSE << "Send size=" << message->size();
+	return sendBuffer(message->data(), message->size(), message->dscp);
+}
+
+bool DtlsTransport::sendBuffer(const byte *data, size_t size, unsigned int dscp) {
+	if (state() != State::Connected)
+		return false;
+
+	PLOG_VERBOSE << "Send size=" << size;
 
 	int ret, err;
 	{
 		std::lock_guard lock(mSslMutex);
-		mCurrentDscp = message->dscp;
-		ret = SSL_write(mSsl, message->data(), int(message->size()));
+		mCurrentDscp = dscp;
+		ret = SSL_write(mSsl, data, int(size));
 		err = SSL_get_error(mSsl, ret);
 	}
 
@@ -895,14 +952,6 @@ void DtlsTransport::incoming(message_ptr message) {
 	enqueueRecv();
 }
 
-bool DtlsTransport::outgoing(message_ptr message) {
-	message->dscp = mCurrentDscp;
-
-	bool result = Transport::outgoing(std::move(message));
-	mOutgoingResult = result;
-	return result;
-}
-
 bool DtlsTransport::demuxMessage(message_ptr) {
 	// Dummy
 	return false;
@@ -920,8 +969,9 @@ void DtlsTransport::doRecv() {
 		return;
 
 	try {
-		const size_t bufferSize = 4096;
-		byte buffer[bufferSize];
+		// Records are read directly into messages sized to the datagram, as a record plaintext
+		// can't be larger, and a message is only allocated again once passed up
+		message_ptr record;
 
 		// Process pending messages
 		while (mIncomingQueue.running()) {
@@ -938,6 +988,8 @@ void DtlsTransport::doRecv() {
 			if (demuxMessage(message))
 				continue;
 
+			mLastArrivalTime = message->arrivalTime;
+
 			BIO_write(mInBio, message->data(), int(message->size()));
 
 			if (state() == State::Connecting) {
@@ -954,7 +1006,7 @@ void DtlsTransport::doRecv() {
 					// See https://www.rfc-editor.org/rfc/rfc8261.html#section-5
 					{
 						std::lock_guard lock(mSslMutex);
-						SSL_set_mtu(mSsl, bufferSize + 1);
+						SSL_set_mtu(mSsl, DTLS_MTU_AFTER_HANDSHAKE);
 					}
 
 					PLOG_INFO << "DTLS handshake finished";
@@ -964,20 +1016,35 @@ void DtlsTransport::doRecv() {
 			}
 
 			if (state() == State::Connected) {
+				// A datagram may carry multiple records, so read until the BIO is drained.
+				// Datagrams are not written to the BIO in batches as a memory BIO does not
+				// preserve their boundaries: a replayed or invalid record would cause the whole
+				// batch to be dropped.
 				int ret, err;
-				{
-					std::lock_guard lock(mSslMutex);
-					ret = SSL_read(mSsl, buffer, bufferSize);
-					err = SSL_get_error(mSsl, ret);
-				}
+				do {
+					if (!record || record->size() < message->size())
+						record = make_message(message->size());
+
+					{
+						std::lock_guard lock(mSslMutex);
+						ret = SSL_read(mSsl, record->data(), int(record->size()));
+						err = SSL_get_error(mSsl, ret);
+					}
+
+					if (err == SSL_ERROR_ZERO_RETURN)
+						break;
+
+					if (openssl::check_error(err)) {
+						record->resize(ret);
+						record->arrivalTime = mLastArrivalTime;
+						recv(std::move(record));
+					}
+				} while (err == SSL_ERROR_NONE);
 
 				if (err == SSL_ERROR_ZERO_RETURN) {
 					PLOG_DEBUG << "TLS connection cleanly closed";
 					break;
 				}
-
-				if (openssl::check_error(err))
-					recv(make_message(buffer, buffer + ret));
 			}
 		}
 
@@ -1072,7 +1139,7 @@ int DtlsTransport::BioMethodWrite(BIO *bio, const char *in, int inl) {
 	if (!transport)
 		return -1;
 	auto b = reinterpret_cast<const byte *>(in);
-	transport->outgoing(make_message(b, b + inl));
+	transport->outgoingRecord(b, inl);
 	return inl; // can't fail
 }
 
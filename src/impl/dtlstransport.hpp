@@ -13,9 +13,11 @@
 #include "common.hpp"
 #include "queue.hpp"
 #include "tls.hpp"
+#include "tlscontextcache.hpp"
 #include "transport.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -38,12 +40,13 @@ public:
 	virtual void start() override;
 	virtual void stop() override;
 	virtual bool send(message_ptr message) override; // false if dropped
+	virtual bool sendBuffer(const byte *data, size_t size, unsigned int dscp) override;
 
 	bool isClient() const { return mIsClient; }
 
 protected:
 	virtual void incoming(message_ptr message) override;
-	virtual bool outgoing(message_ptr message) override;
+	bool outgoingRecord(const byte *data, size_t size);
 	virtual bool demuxMessage(message_ptr message);
 	virtual void postHandshake();
 
@@ -58,12 +61,14 @@ protected:
 	Queue<message_ptr> mIncomingQueue;
 	std::atomic<int> mPendingRecvCount = 0;
 	std::mutex mRecvMutex;
+	optional<std::chrono::steady_clock::time_point> mLastArrivalTime; // under mRecvMutex
 	std::atomic<unsigned int> mCurrentDscp = 0;
 	std::atomic<bool> mOutgoingResult = true;
 
 #if USE_GNUTLS
 	gnutls_session_t mSession;
 	std::mutex mSendMutex;
+	binary mRecordBuffer; // under mRecvMutex
 
 	static int CertificateCallback(gnutls_session_t session);
 	static ssize_t WriteCallback(gnutls_transport_ptr_t ptr, const void *data, size_t len);
@@ -71,12 +76,11 @@ protected:
 	static int TimeoutCallback(gnutls_transport_ptr_t ptr, unsigned int ms);
 
 #elif USE_MBEDTLS
-	mbedtls_entropy_context mEntropy;
-	mbedtls_ctr_drbg_context mDrbg;
-	mbedtls_ssl_config mConf;
+	shared_ptr<mbedtls_ssl_config> mConf;
 	mbedtls_ssl_context mSsl;
 
 	std::mutex mSslMutex;
+	binary mRecordBuffer; // under mRecvMutex
 
 	uint32_t mFinMs = 0, mIntMs = 0;
 	std::chrono::time_point<std::chrono::steady_clock> mTimerSetAt;
@@ -85,6 +89,11 @@ protected:
 	char mRandBytes[64];
 	mbedtls_tls_prf_types mTlsProfile = MBEDTLS_SSL_TLS_PRF_NONE;
 
+	void logConnectionId();
+
+	static TlsContextCache<mbedtls_ssl_config> ConfigCache;
+
+	static shared_ptr<mbedtls_ssl_config> CreateConfig(certificate_ptr certificate, bool isClient);
 	static int CertificateCallback(void *ctx, mbedtls_x509_crt *crt, int depth, uint32_t *flags);
 	static int WriteCallback(void *ctx, const unsigned char *buf, size_t len);
 	static int ReadCallback(void *ctx, unsigned char *buf, size_t len);
@@ -97,7 +106,7 @@ protected:
 	static int GetTimerCallback(void *ctx);
 
 #else // OPENSSL
-	SSL_CTX *mCtx = NULL;
+	shared_ptr<SSL_CTX> mCtx;
 	SSL *mSsl = NULL;
 	BIO *mInBio, *mOutBio;
 	std::mutex mSslMutex;
@@ -107,6 +116,9 @@ protected:
 	static BIO_METHOD *BioMethods;
 	static int TransportExIndex;
 	static std::mutex GlobalMutex;
+	static TlsContextCache<SSL_CTX> ContextCache;
+
+	static shared_ptr<SSL_CTX> CreateContext(certificate_ptr certificate);
 
 	static int CertificateCallback(int preverify_ok, X509_STORE_CTX *ctx);
 	static void InfoCallback(const SSL *ssl, int where, int ret);
@@ -9,6 +9,7 @@
 #include "icetransport.hpp"
 #include "configuration.hpp"
 #include "internals.hpp"
+#include "resolver.hpp"
 #include "transport.hpp"
 #include "utils.hpp"
 
@@ -49,13 +50,15 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
                            state_callback stateChangeCallback,
                            gathering_state_callback gatheringStateChangeCallback)
     : Transport(nullptr, std::move(stateChangeCallback)), mRole(Description::Role::ActPass),
-      mMid("0"), mGatheringState(GatheringState::New),
+      mMid("0"), mGatheringState(GatheringState::New), mEnableEcn(config.enableEcn),
       mCandidateCallback(std::move(candidateCallback)),
       mGatheringStateChangeCallback(std::move(gatheringStateChangeCallback)),
       mAgent(nullptr, nullptr) {
 
 	PLOG_DEBUG << "Initializing ICE transport (libjuice)";
 
+	initScheduler(config);
+
 	juice_log_level_t level;
 	auto logger = plog::get();
 	switch (logger ? logger->getMaxSeverity() : plog::none) {
@@ -93,6 +96,10 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 		PLOG_WARNING << "ICE-TCP is not supported with libjuice";
 	}
 
+	if (config.enableIceLite) {
+		PLOG_WARNING << "ICE-lite is not supported with libjuice";
+	}
+
 	if (config.enableIceUdpMux) {
 		PLOG_DEBUG << "Enabling ICE UDP mux";
 		jconfig.concurrency_mode = JUICE_CONCURRENCY_MODE_MUX;
@@ -110,6 +117,7 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 			if (server.port == 0)
 				server.port = 3478; // STUN UDP port
 			PLOG_INFO << "Using STUN server \"" << server.hostname << ":" << server.port << "\"";
+			server.hostname = CachedServerHost(server.hostname, server.port);
 			jconfig.stun_server_host = server.hostname.c_str();
 			jconfig.stun_server_port = server.port;
 			break;
@@ -126,6 +134,7 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 			if (server.port == 0)
 				server.port = 3478; // TURN UDP port
 			PLOG_INFO << "Using TURN server \"" << server.hostname << ":" << server.port << "\"";
+			server.hostname = CachedServerHost(server.hostname, server.port);
 			turn_servers[k].host = server.hostname.c_str();
 			turn_servers[k].username = server.username.c_str();
 			turn_servers[k].password = server.password.c_str();
@@ -157,11 +166,16 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 
 IceTransport::~IceTransport() {
 	PLOG_DEBUG << "Destroying ICE transport";
+	if (mScheduler)
+		mScheduler->stop();
+
 	mAgent.reset();
 }
 
 Description::Role IceTransport::role() const { return mRole; }
 
+void IceTransport::setRole(Description::Role role) { mRole = role; }
+
 Description IceTransport::getLocalDescription(Description::Type type) const {
 	char sdp[JUICE_MAX_SDP_STRING_LEN];
 	if (juice_get_local_description(mAgent.get(), sdp, JUICE_MAX_SDP_STRING_LEN) < 0)
@@ -264,11 +278,44 @@ bool IceTransport::send(message_ptr message) {
 	return outgoing(message);
 }
 
+bool IceTransport::sendBuffer(const byte *data, size_t size, unsigned int dscp) {
+	auto s = state();
+	if (s != State::Connected && s != State::Completed)
+		return false;
+
+	PLOG_VERBOSE << "Send size=" << size;
+	if (mScheduler)
+		return mScheduler->send(data, size, dscp);
+
+	return sendDatagram(data, size, dscp);
+}
+
+size_t IceTransport::sendBatch(const message_vector &messages) {
+	auto s = state();
+	if (s != State::Connected && s != State::Completed)
+		return 0;
+
+	PLOG_VERBOSE << "Send batch count=" << messages.size();
+
+	// libjuice owns the socket and only exposes single datagram sends
+	size_t count = 0;
+	for (const auto &message : messages)
+		if (message && outgoing(message))
+			++count;
+
+	return count;
+}
+
 bool IceTransport::outgoing(message_ptr message) {
-	// Explicit Congestion Notification takes the least-significant 2 bits of the DS field
-	int ds = int(message->dscp << 2);
-	return juice_send_diffserv(mAgent.get(), reinterpret_cast<const char *>(message->data()),
-	                           message->size(), ds) >= 0;
+	if (mScheduler)
+		return mScheduler->send(message);
+
+	return sendDatagram(message->data(), message->size(), message->dscp);
+}
+
+bool IceTransport::sendDatagram(const byte *data, size_t size, unsigned int dscp) {
+	int ds = diffServ(data, size, dscp);
+	return juice_send_diffserv(mAgent.get(), reinterpret_cast<const char *>(data), size, ds) >= 0;
 }
 
 void IceTransport::changeGatheringState(GatheringState state) {
@@ -330,16 +377,38 @@ void IceTransport::GatheringDoneCallback(juice_agent_t *, void *user_ptr) {
 }
 
 void IceTransport::RecvCallback(juice_agent_t *, const char *data, size_t size, void *user_ptr) {
+	// Take the arrival time first, the socket is owned by libjuice so the kernel timestamp is
+	// not available
+	auto arrivalTime = std::chrono::steady_clock::now();
 	auto iceTransport = static_cast<rtc::impl::IceTransport *>(user_ptr);
 	try {
 		PLOG_VERBOSE << "Incoming size=" << size;
 		auto b = reinterpret_cast<const byte *>(data);
-		iceTransport->incoming(make_message(b, b + size));
+		auto message = make_message(b, b + size);
+		message->arrivalTime = arrivalTime;
+		iceTransport->incoming(std::move(message));
 	} catch (const std::exception &e) {
 		PLOG_WARNING << e.what();
 	}
 }
 
+string IceTransport::CachedServerHost(const string &hostname, uint16_t port) {
+	// libjuice resolves server hostnames by itself, so pass a numeric address if one is cached, and
+	// otherwise resolve in the background so the next connections are served from memory
+	auto service = std::to_string(port);
+	if (auto addresses = Resolver::Instance().lookup(hostname, service, SOCK_DGRAM)) {
+		for (const auto &[addr, addrlen] : *addresses) {
+			char nodebuffer[MAX_NUMERICNODE_LEN];
+			if (getnameinfo(reinterpret_cast<const struct sockaddr *>(&addr), addrlen, nodebuffer,
+			                MAX_NUMERICNODE_LEN, nullptr, 0, NI_NUMERICHOST) == 0)
+				return nodebuffer;
+		}
+	}
+
+	Resolver::Instance().resolve(hostname, service, SOCK_DGRAM, nullptr);
+	return hostname;
+}
+
 void IceTransport::LogCallback(juice_log_level_t level, const char *message) {
 	plog::Severity severity;
 	switch (level) {
@@ -400,13 +469,15 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
                            state_callback stateChangeCallback,
                            gathering_state_callback gatheringStateChangeCallback)
     : Transport(nullptr, std::move(stateChangeCallback)), mRole(Description::Role::ActPass),
-      mMid("0"), mGatheringState(GatheringState::New),
+      mMid("0"), mGatheringState(GatheringState::New), mEnableEcn(config.enableEcn),
       mCandidateCallback(std::move(candidateCallback)),
       mGatheringStateChangeCallback(std::move(gatheringStateChangeCallback)),
-      mNiceAgent(nullptr, nullptr), mOutgoingDscp(0) {
+      mNiceAgent(nullptr, nullptr), mOutgoingDs(0), mIceLite(config.enableIceLite) {
 
 	PLOG_DEBUG << "Initializing ICE transport (libnice)";
 
+	initScheduler(config);
+
 	if (!MainLoop)
 		throw std::logic_error("Main loop for nice agent is not created");
 
@@ -416,6 +487,14 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 	// See https://gitlab.freedesktop.org/libnice/libnice/-/merge_requests/125
 	NiceAgentOption flags = NICE_AGENT_OPTION_REGULAR_NOMINATION;
 
+	// RFC 8445: Lite implementations only utilize host candidates. [...] A lite implementation
+	// does not generate connectivity checks or run state machines, though it does need to be able
+	// to respond to connectivity checks.
+	if (mIceLite) {
+		PLOG_DEBUG << "Enabling ICE-lite mode";
+		flags = NiceAgentOption(flags | NICE_AGENT_OPTION_LITE_MODE);
+	}
+
 	// Create agent
 	mNiceAgent = decltype(mNiceAgent)(
 	    nice_agent_new_full(
@@ -486,6 +565,11 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 	std::vector<IceServer> servers = config.iceServers;
 	std::shuffle(servers.begin(), servers.end(), utils::random_engine());
 
+	if (mIceLite && !servers.empty()) {
+		PLOG_WARNING << "ICE servers are ignored in ICE-lite mode";
+		servers.clear();
+	}
+
 	// Add one STUN server
 	bool success = false;
 	for (auto &server : servers) {
@@ -496,25 +580,20 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 		if (server.port == 0)
 			server.port = 3478; // STUN UDP port
 
-		struct addrinfo hints = {};
-		hints.ai_family = AF_INET; // IPv4
-		hints.ai_socktype = SOCK_DGRAM;
-		hints.ai_protocol = IPPROTO_UDP;
-		hints.ai_flags = AI_ADDRCONFIG;
-		struct addrinfo *result = nullptr;
-		if (getaddrinfo(server.hostname.c_str(), std::to_string(server.port).c_str(), &hints,
-		                &result) != 0) {
+		auto addresses = Resolver::Instance().resolve(server.hostname,
+		                                              std::to_string(server.port), SOCK_DGRAM);
+		if (!addresses) {
 			PLOG_WARNING << "Unable to resolve STUN server address: " << server.hostname << ':'
 			             << server.port;
 			continue;
 		}
 
-		for (auto p = result; p; p = p->ai_next) {
-			if (p->ai_family == AF_INET) {
+		for (const auto &[addr, addrlen] : *addresses) {
+			if (addr.ss_family == AF_INET) { // IPv4
 				char nodebuffer[MAX_NUMERICNODE_LEN];
 				char servbuffer[MAX_NUMERICSERV_LEN];
-				if (getnameinfo(p->ai_addr, p->ai_addrlen, nodebuffer, MAX_NUMERICNODE_LEN,
-				                servbuffer, MAX_NUMERICSERV_LEN,
+				if (getnameinfo(reinterpret_cast<const struct sockaddr *>(&addr), addrlen,
+				                nodebuffer, MAX_NUMERICNODE_LEN, servbuffer, MAX_NUMERICSERV_LEN,
 				                NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
 					PLOG_INFO << "Using STUN server \"" << server.hostname << ":" << server.port
 					          << "\"";
@@ -527,7 +606,6 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 			}
 		}
 
-		freeaddrinfo(result);
 		if (success)
 			break;
 	}
@@ -541,27 +619,22 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 		if (server.port == 0)
 			server.port = server.relayType == IceServer::RelayType::TurnTls ? 5349 : 3478;
 
-		struct addrinfo hints = {};
-		hints.ai_family = AF_UNSPEC;
-		hints.ai_socktype =
+		int socktype =
 		    server.relayType == IceServer::RelayType::TurnUdp ? SOCK_DGRAM : SOCK_STREAM;
-		hints.ai_protocol =
-		    server.relayType == IceServer::RelayType::TurnUdp ? IPPROTO_UDP : IPPROTO_TCP;
-		hints.ai_flags = AI_ADDRCONFIG;
-		struct addrinfo *result = nullptr;
-		if (getaddrinfo(server.hostname.c_str(), std::to_string(server.port).c_str(), &hints,
-		                &result) != 0) {
+		auto addresses =
+		    Resolver::Instance().resolve(server.hostname, std::to_string(server.port), socktype);
+		if (!addresses) {
 			PLOG_WARNING << "Unable to resolve TURN server address: " << server.hostname << ':'
 			             << server.port;
 			continue;
 		}
 
-		for (auto p = result; p; p = p->ai_next) {
-			if (p->ai_family == AF_INET || p->ai_family == AF_INET6) {
+		for (const auto &[addr, addrlen] : *addresses) {
+			if (addr.ss_family == AF_INET || addr.ss_family == AF_INET6) {
 				char nodebuffer[MAX_NUMERICNODE_LEN];
 				char servbuffer[MAX_NUMERICSERV_LEN];
-				if (getnameinfo(p->ai_addr, p->ai_addrlen, nodebuffer, MAX_NUMERICNODE_LEN,
-				                servbuffer, MAX_NUMERICSERV_LEN,
+				if (getnameinfo(reinterpret_cast<const struct sockaddr *>(&addr), addrlen,
+				                nodebuffer, MAX_NUMERICNODE_LEN, servbuffer, MAX_NUMERICSERV_LEN,
 				                NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
 					PLOG_INFO << "Using TURN server \"" << server.hostname << ":" << server.port
 					          << "\"";
@@ -583,8 +656,6 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 				}
 			}
 		}
-
-		freeaddrinfo(result);
 	}
 
 	g_signal_connect(G_OBJECT(mNiceAgent.get()), "component-state-changed",
@@ -609,6 +680,9 @@ IceTransport::~IceTransport() {
 	}
 
 	PLOG_DEBUG << "Destroying ICE transport";
+	if (mScheduler)
+		mScheduler->stop();
+
 	nice_agent_attach_recv(mNiceAgent.get(), mStreamId, 1, g_main_loop_get_context(MainLoop.get()),
 	                       NULL, NULL);
 	nice_agent_remove_stream(mNiceAgent.get(), mStreamId);
@@ -617,11 +691,16 @@ IceTransport::~IceTransport() {
 
 Description::Role IceTransport::role() const { return mRole; }
 
+void IceTransport::setRole(Description::Role role) { mRole = role; }
+
 Description IceTransport::getLocalDescription(Description::Type type) const {
 	// RFC 8445: The initiating agent that started the ICE processing MUST take the controlling
-	// role, and the other MUST take the controlled role.
-	g_object_set(G_OBJECT(mNiceAgent.get()), "controlling-mode",
-	             type == Description::Type::Offer ? TRUE : FALSE, nullptr);
+	// role, and the other MUST take the controlled role. [...] If one agent is full and one is
+	// lite, the full agent MUST take the controlling role, and the lite agent MUST take the
+	// controlled role.
+	bool controlling = (type == Description::Type::Offer || mRemoteIceLite) && !mIceLite;
+	g_object_set(G_OBJECT(mNiceAgent.get()), "controlling-mode", controlling ? TRUE : FALSE,
+	             nullptr);
 
 	unique_ptr<gchar[], void (*)(void *)> sdp(nice_agent_generate_local_sdp(mNiceAgent.get()),
 	                                          g_free);
@@ -632,6 +711,9 @@ Description IceTransport::getLocalDescription(Description::Type type) const {
 	Description desc(string(sdp.get()), type,
 	                 type == Description::Type::Offer ? Description::Role::ActPass : mRole);
 	desc.addIceOption("trickle");
+	if (mIceLite)
+		desc.setIceLite(true);
+
 	return desc;
 }
 
@@ -654,6 +736,15 @@ void IceTransport::setRemoteDescription(const Description &description) {
 	if (mRole == description.role())
 		throw std::invalid_argument("Incompatible roles with remote description");
 
+	// RFC 8445: If one agent is full and one is lite, the full agent MUST take the controlling role
+	mRemoteIceLite = description.iceLite();
+	if (mRemoteIceLite) {
+		if (mIceLite)
+			PLOG_WARNING << "Both ICE agents are lite implementations";
+		else
+			g_object_set(G_OBJECT(mNiceAgent.get()), "controlling-mode", TRUE, nullptr);
+	}
+
 	mMid = description.bundleMid();
 	mTrickleTimeout = !description.ended() ? 30s : 0s;
 
@@ -723,16 +814,103 @@ bool IceTransport::send(message_ptr message) {
 	return outgoing(message);
 }
 
-bool IceTransport::outgoing(message_ptr message) {
+bool IceTransport::sendBuffer(const byte *data, size_t size, unsigned int dscp) {
+	auto s = state();
+	if (s != State::Connected && s != State::Completed)
+		return false;
+
+	PLOG_VERBOSE << "Send size=" << size;
+	if (mScheduler)
+		return mScheduler->send(data, size, dscp);
+
+	return sendDatagram(data, size, dscp);
+}
+
+size_t IceTransport::sendBatch(const message_vector &messages) {
+	auto s = state();
+	if (s != State::Connected && s != State::Completed)
+		return 0;
+
+	PLOG_VERBOSE << "Send batch count=" << messages.size();
+
+	if (mScheduler) {
+		// Datagrams might be queued separately by priority class
+		size_t count = 0;
+		for (const auto &message : messages)
+			if (message && mScheduler->send(message))
+				++count;
+
+		return count;
+	}
+
+	// Capacity is reserved so output messages can point into the buffers vector
+	std::vector<GOutputVector> buffers;
+	std::vector<NiceOutputMessage> outputs;
+	buffers.reserve(messages.size());
+	outputs.reserve(messages.size());
+
 	std::lock_guard lock(mOutgoingMutex);
-	if (mOutgoingDscp != message->dscp) {
-		mOutgoingDscp = message->dscp;
-		// Explicit Congestion Notification takes the least-significant 2 bits of the DS field
-		int ds = int(message->dscp << 2);
-		nice_agent_set_stream_tos(mNiceAgent.get(), mStreamId, ds); // ToS is the legacy name for DS
+	size_t count = 0;
+	auto flush = [&]() {
+		if (outputs.empty())
+			return;
+
+		GError *error = NULL;
+		gint ret = nice_agent_send_messages_nonblocking(mNiceAgent.get(), mStreamId, 1,
+		                                                outputs.data(), guint(outputs.size()),
+		                                                NULL, &error);
+		if (ret >= 0) {
+			count += size_t(ret);
+		} else if (error) {
+			PLOG_WARNING << "ICE batch send failed: " << error->message;
+		}
+
+		if (error)
+			g_error_free(error);
+
+		buffers.clear();
+		outputs.clear();
+	};
+
+	// The DS field is set on the stream, so datagrams are sent in runs of identical DS values
+	for (const auto &message : messages) {
+		if (!message)
+			continue;
+
+		int ds = diffServ(message->data(), message->size(), message->dscp);
+		if (mOutgoingDs != ds) {
+			flush();
+			setOutgoingDs(ds);
+		}
+
+		buffers.push_back(GOutputVector{message->data(), message->size()});
+		outputs.push_back(NiceOutputMessage{&buffers.back(), 1});
 	}
-	return nice_agent_send(mNiceAgent.get(), mStreamId, 1, message->size(),
-	                       reinterpret_cast<const char *>(message->data())) >= 0;
+
+	flush();
+	return count;
+}
+
+bool IceTransport::outgoing(message_ptr message) {
+	if (mScheduler)
+		return mScheduler->send(message);
+
+	return sendDatagram(message->data(), message->size(), message->dscp);
+}
+
+bool IceTransport::sendDatagram(const byte *data, size_t size, unsigned int dscp) {
+	std::lock_guard lock(mOutgoingMutex);
+	int ds = diffServ(data, size, dscp);
+	if (mOutgoingDs != ds)
+		setOutgoingDs(ds);
+
+	return nice_agent_send(mNiceAgent.get(), mStreamId, 1, size,
+	                       reinterpret_cast<const char *>(data)) >= 0;
+}
+
+void IceTransport::setOutgoingDs(int ds) {
+	mOutgoingDs = ds;
+	nice_agent_set_stream_tos(mNiceAgent.get(), mStreamId, ds); // ToS is the legacy name for DS
 }
 
 void IceTransport::changeGatheringState(GatheringState state) {
@@ -827,11 +1005,16 @@ void IceTransport::StateChangeCallback(NiceAgent * /*agent*/, guint /*streamId*/
 
 void IceTransport::RecvCallback(NiceAgent * /*agent*/, guint /*streamId*/, guint /*componentId*/,
                                 guint len, gchar *buf, gpointer userData) {
+	// Take the arrival time first, the socket is owned by libnice so the kernel timestamp is not
+	// available
+	auto arrivalTime = std::chrono::steady_clock::now();
 	auto iceTransport = static_cast<rtc::impl::IceTransport *>(userData);
 	try {
 		PLOG_VERBOSE << "Incoming size=" << len;
 		auto b = reinterpret_cast<byte *>(buf);
-		iceTransport->incoming(make_message(b, b + len));
+		auto message = make_message(b, b + len);
+		message->arrivalTime = arrivalTime;
+		iceTransport->incoming(std::move(message));
 	} catch (const std::exception &e) {
 		PLOG_WARNING << e.what();
 	}
@@ -891,4 +1074,40 @@ bool IceTransport::getSelectedCandidatePair(Candidate *local, Candidate *remote)
 
 #endif
 
+void IceTransport::initScheduler(const Configuration &config) {
+	if (!config.sendRateBudget)
+		return;
+
+	PLOG_DEBUG << "Send scheduler rate budget: " << *config.sendRateBudget << " bytes/s";
+	mScheduler = std::make_shared<SendScheduler>(
+	    config, [this](const byte *data, size_t size, unsigned int dscp) {
+		    return sendDatagram(data, size, dscp);
+	    });
+}
+
+void IceTransport::clearStats() {
+	if (mScheduler)
+		mScheduler->clearStats();
+}
+
+SendQueueStats IceTransport::sendQueueStats() const {
+	return mScheduler ? mScheduler->stats() : SendQueueStats{};
+}
+
+int IceTransport::diffServ(const byte *data, size_t size, unsigned int dscp) const {
+	// Explicit Congestion Notification takes the least-significant 2 bits of the DS field
+	int ds = int(dscp << 2);
+
+	// RFC 5764: If the value [of the first byte] is in between 128 and 191 (inclusive), then the
+	// packet is RTP (or RTCP)
+	// Only media is marked since SCTP over DTLS does not react to congestion marks
+	if (mEnableEcn && size > 0) {
+		uint8_t first = std::to_integer<uint8_t>(data[0]);
+		if (first >= 128 && first <= 191)
+			ds |= ECN_ECT1;
+	}
+
+	return ds;
+}
+
 } // namespace rtc::impl
@@ -15,6 +15,7 @@
 #include "description.hpp"
 #include "global.hpp"
 #include "peerconnection.hpp"
+#include "sendscheduler.hpp"
 #include "transport.hpp"
 
 #if !USE_NICE
@@ -46,6 +47,7 @@ public:
 	~IceTransport();
 
 	Description::Role role() const;
+	void setRole(Description::Role role); // keep the previous role on ICE restart
 	GatheringState gatheringState() const;
 	Description getLocalDescription(Description::Type type) const;
 	void setRemoteDescription(const Description &description);
@@ -56,11 +58,20 @@ public:
 	optional<string> getRemoteAddress() const;
 
 	bool send(message_ptr message) override; // false if dropped
+	bool sendBuffer(const byte *data, size_t size, unsigned int dscp) override;
+	size_t sendBatch(const message_vector &messages) override;
 
 	bool getSelectedCandidatePair(Candidate *local, Candidate *remote);
 
+	// Stats
+	void clearStats();
+	SendQueueStats sendQueueStats() const;
+
 private:
 	bool outgoing(message_ptr message) override;
+	bool sendDatagram(const byte *data, size_t size, unsigned int dscp);
+	int diffServ(const byte *data, size_t size, unsigned int dscp) const;
+	void initScheduler(const Configuration &config);
 
 	void changeGatheringState(GatheringState state);
 
@@ -73,9 +84,11 @@ private:
 	string mMid;
 	std::chrono::milliseconds mTrickleTimeout;
 	std::atomic<GatheringState> mGatheringState;
+	const bool mEnableEcn;
 
 	candidate_callback mCandidateCallback;
 	gathering_state_callback mGatheringStateChangeCallback;
+	shared_ptr<SendScheduler> mScheduler; // null if no rate budget is configured
 
 #if !USE_NICE
 	unique_ptr<juice_agent_t, void (*)(juice_agent_t *)> mAgent;
@@ -85,6 +98,7 @@ private:
 	static void GatheringDoneCallback(juice_agent_t *agent, void *user_ptr);
 	static void RecvCallback(juice_agent_t *agent, const char *data, size_t size, void *user_ptr);
 	static void LogCallback(juice_log_level_t level, const char *message);
+	static string CachedServerHost(const string &hostname, uint16_t port);
 #else
 	static unique_ptr<GMainLoop, void (*)(GMainLoop *)> MainLoop;
 	static std::thread MainLoopThread;
@@ -93,7 +107,11 @@ private:
 	uint32_t mStreamId = 0;
 	guint mTimeoutId = 0;
 	std::mutex mOutgoingMutex;
-	unsigned int mOutgoingDscp;
+	int mOutgoingDs;
+	const bool mIceLite;
+	bool mRemoteIceLite = false;
+
+	void setOutgoingDs(int ds); // mOutgoingMutex must be held
 
 	static string AddressToString(const NiceAddress &addr);
 
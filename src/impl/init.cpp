@@ -12,6 +12,7 @@
 #include "icetransport.hpp"
 #include "internals.hpp"
 #include "pollservice.hpp"
+#include "resolver.hpp"
 #include "sctptransport.hpp"
 #include "threadpool.hpp"
 #include "tls.hpp"
@@ -91,6 +92,9 @@ void Init::preload() {
 }
 
 std::shared_future<void> Init::cleanup() {
+	// Pooled certificates hold tokens, release them first
+	CertificateProvider::Instance().clear();
+
 	std::lock_guard lock(mMutex);
 	mGlobal.reset();
 	return mCleanupFuture;
@@ -122,6 +126,7 @@ void Init::doInit() {
 	int count = std::max(concurrency, MIN_THREADPOOL_SIZE);
 	PLOG_DEBUG << "Spawning " << count << " threads";
 	ThreadPool::Instance().spawn(count);
+	Resolver::Instance().start();
 
 #if RTC_ENABLE_WEBSOCKET
 	PollService::Instance().start();
@@ -157,6 +162,9 @@ void Init::doCleanup() {
 
 	PLOG_DEBUG << "Global cleanup";
 
+	// Resolver callbacks enqueue tasks on the thread pool, so the resolver must be joined first
+	Resolver::Instance().join();
+	Resolver::Instance().clear();
 	ThreadPool::Instance().join();
 	ThreadPool::Instance().clear();
 #if RTC_ENABLE_WEBSOCKET
@@ -11,6 +11,8 @@
 
 #include "common.hpp"
 
+#include <chrono>
+
 // Disable warnings before including plog
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
@@ -43,10 +45,31 @@ const size_t DEFAULT_MAX_MESSAGE_SIZE = 65536; // Remote max message size if not
 
 const size_t RECV_QUEUE_LIMIT = 1024 * 1024; // Max per-channel queue size
 
+const size_t RECV_QUEUE_HIGH_THRESHOLD = 1024 * 1024; // Queued bytes to stop reading from SCTP
+const size_t RECV_QUEUE_LOW_THRESHOLD = 256 * 1024;   // Queued bytes to resume reading from SCTP
+
 const int MIN_THREADPOOL_SIZE = 4; // Minimum number of threads in the global thread pool (>= 2)
 
+const int RESOLVER_THREADS_COUNT = 2; // Number of threads dedicated to name resolution
+
+const auto RESOLVER_CACHE_TTL = std::chrono::seconds(60);         // Lifetime of a resolved name
+const auto RESOLVER_NEGATIVE_CACHE_TTL = std::chrono::seconds(5); // Lifetime of a failure
+
+// Interval to check again for the certificate while warming up a pooled PeerConnection
+const auto PEER_CONNECTION_POOL_RETRY_INTERVAL = std::chrono::milliseconds(10);
+
 const size_t DEFAULT_MTU = RTC_DEFAULT_MTU; // defined in rtc.h
 
+// Max burst of the send scheduler at the configured rate, and min interval between drains
+const auto SEND_SCHEDULER_BURST = std::chrono::milliseconds(10);
+const auto SEND_SCHEDULER_MIN_INTERVAL = std::chrono::milliseconds(1);
+
+const int ECN_ECT1 = 0x01; // ECN-Capable Transport ECT(1) codepoint, identifies L4S (RFC 9331)
+
+const size_t DTLS_MAX_RECORD_SIZE = 16384;    // Max DTLS record plaintext size (RFC 6347)
+const size_t DTLS_CONNECTION_ID_SIZE = 8;     // Size of the local DTLS Connection ID (RFC 9146)
+const size_t DTLS_MTU_AFTER_HANDSHAKE = 4097; // Lets records exceed the path MTU (RFC 8261)
+
 } // namespace rtc
 
 #endif
@@ -28,7 +28,6 @@
 #include <iomanip>
 #include <set>
 #include <sstream>
-#include <thread>
 
 using namespace std::placeholders;
 
@@ -45,7 +44,7 @@ static LogCounter
                                 "Number of unknown RTCP packet types over past second");
 
 PeerConnection::PeerConnection(Configuration config_)
-    : config(std::move(config_)), mCertificate(make_certificate(config.certificateType)) {
+    : config(std::move(config_)), mCertificate(make_certificate(config)) {
 	PLOG_VERBOSE << "Creating PeerConnection";
 
 	if (config.portRangeEnd && config.portRangeBegin > config.portRangeEnd)
@@ -90,6 +89,22 @@ void PeerConnection::remoteClose() {
 	}
 }
 
+bool PeerConnection::prewarm() {
+	// Wait for the certificate without blocking, as it is generated on the thread pool
+	if (mCertificate.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return false;
+
+	auto iceTransport = initIceTransport();
+	if (!iceTransport)
+		return true; // closed
+
+	// Gather candidates now, they are buffered until the local description assigns their mid
+	if (gatheringState == GatheringState::New)
+		iceTransport->gatherLocalCandidates("");
+
+	return true;
+}
+
 optional<Description> PeerConnection::localDescription() const {
 	std::lock_guard lock(mLocalDescriptionMutex);
 	return mLocalDescription;
@@ -144,19 +159,30 @@ shared_ptr<IceTransport> PeerConnection::initIceTransport() {
 
 		PLOG_VERBOSE << "Starting ICE transport";
 
+		// Callbacks from a transport replaced by an ICE restart are ignored
+		const unsigned int generation = mIceGeneration;
+
 		auto transport = std::make_shared<IceTransport>(
-		    config, weak_bind(&PeerConnection::processLocalCandidate, this, _1),
-		    [this, weak_this = weak_from_this()](IceTransport::State transportState) {
+		    config,
+		    [this, weak_this = weak_from_this(), generation](const Candidate &candidate) {
 			    auto shared_this = weak_this.lock();
-			    if (!shared_this)
+			    if (!shared_this || generation != mIceGeneration)
+				    return;
+			    processLocalCandidate(candidate);
+		    },
+		    [this, weak_this = weak_from_this(), generation](IceTransport::State transportState) {
+			    auto shared_this = weak_this.lock();
+			    if (!shared_this || generation != mIceGeneration)
 				    return;
 			    switch (transportState) {
 			    case IceTransport::State::Connecting:
 				    changeIceState(IceState::Checking);
-				    changeState(State::Connecting);
+				    if (state != State::Connected) // the connection is kept during ICE restart
+					    changeState(State::Connecting);
 				    break;
 			    case IceTransport::State::Connected:
 				    changeIceState(IceState::Connected);
+				    completeIceRestart();
 				    initDtlsTransport();
 				    break;
 			    case IceTransport::State::Completed:
@@ -177,9 +203,10 @@ shared_ptr<IceTransport> PeerConnection::initIceTransport() {
 				    break;
 			    }
 		    },
-		    [this, weak_this = weak_from_this()](IceTransport::GatheringState gatheringState) {
+		    [this, weak_this = weak_from_this(),
+		     generation](IceTransport::GatheringState gatheringState) {
 			    auto shared_this = weak_this.lock();
-			    if (!shared_this)
+			    if (!shared_this || generation != mIceGeneration)
 				    return;
 			    switch (gatheringState) {
 			    case IceTransport::GatheringState::InProgress:
@@ -204,6 +231,58 @@ shared_ptr<IceTransport> PeerConnection::initIceTransport() {
 	}
 }
 
+shared_ptr<IceTransport> PeerConnection::restartIceTransport() {
+	auto previous = std::atomic_load(&mIceTransport);
+	if (!previous)
+		return initIceTransport();
+
+	PLOG_INFO << "Restarting ICE";
+
+	// The previous transport keeps carrying DTLS until the new one is connected
+	++mIceGeneration;
+	std::atomic_store(&mIceTransport, decltype(mIceTransport)(nullptr));
+	auto transport = initIceTransport();
+	if (!transport)
+		return nullptr; // closed
+
+	transport->setRole(previous->role());
+
+	// Candidates of the previous ICE session are now obsolete
+	{
+		std::lock_guard lock(mLocalDescriptionMutex);
+		if (mLocalDescription)
+			mLocalDescription->extractCandidates();
+	}
+	{
+		std::lock_guard lock(mRemoteDescriptionMutex);
+		if (mRemoteDescription)
+			mRemoteDescription->extractCandidates();
+	}
+
+	changeGatheringState(GatheringState::New);
+	return transport;
+}
+
+void PeerConnection::completeIceRestart() {
+	auto dtlsTransport = std::atomic_load(&mDtlsTransport);
+	auto iceTransport = std::atomic_load(&mIceTransport);
+	if (!dtlsTransport || !iceTransport)
+		return;
+
+	// Move DTLS over to the new ICE transport, SCTP and tracks above are left untouched
+	auto previous = dtlsTransport->replaceLower(iceTransport);
+	if (!previous)
+		return;
+
+	PLOG_INFO << "ICE restart completed";
+	previous->onStateChange(nullptr);
+	TearDownProcessor::Instance().enqueue(
+	    [previous = std::move(previous), token = Init::Instance().token()]() mutable {
+		    previous->stop();
+		    previous.reset();
+	    });
+}
+
 shared_ptr<DtlsTransport> PeerConnection::initDtlsTransport() {
 	try {
 		if (auto transport = std::atomic_load(&mDtlsTransport))
@@ -398,6 +477,8 @@ void PeerConnection::endLocalCandidates() {
 	std::lock_guard lock(mLocalDescriptionMutex);
 	if (mLocalDescription)
 		mLocalDescription->endCandidates();
+	else
+		mPrewarmedCandidatesEnded = true;
 }
 
 void PeerConnection::rollbackLocalDescription() {
@@ -415,6 +496,16 @@ void PeerConnection::rollbackLocalDescription() {
 	}
 }
 
+bool PeerConnection::isIceRestart(const Description &description) const {
+	// RFC 8839: To restart ICE, an agent MUST change both the ice-pwd and the ice-ufrag for the
+	// data stream in an offer.
+	std::lock_guard lock(mRemoteDescriptionMutex);
+	if (!mRemoteDescription || !mRemoteDescription->iceUfrag() || !description.iceUfrag())
+		return false;
+
+	return *description.iceUfrag() != *mRemoteDescription->iceUfrag();
+}
+
 bool PeerConnection::checkFingerprint(const std::string &fingerprint) const {
 	std::lock_guard lock(mRemoteDescriptionMutex);
 	auto expectedFingerprint = mRemoteDescription ? mRemoteDescription->fingerprint() : nullopt;
@@ -557,8 +648,14 @@ void PeerConnection::forwardMedia(message_ptr message) {
 			std::shared_lock lock(mTracksMutex); // read-only
 			for (uint32_t ssrc : ssrcs) {
 				if (auto it = mTracksBySsrc.find(ssrc); it != mTracksBySsrc.end()) {
-					if (auto track = it->second.lock())
-						track->incoming(message);
+					if (auto track = it->second.lock()) {
+						// With pipelining, tracks process the message concurrently so each one
+						// needs its own copy
+						if (config.enableMediaPipelining)
+							track->enqueueIncoming(std::make_shared<Message>(*message));
+						else
+							track->incoming(message);
+					}
 				}
 			}
 			return;
@@ -569,8 +666,12 @@ void PeerConnection::forwardMedia(message_ptr message) {
 
 	std::shared_lock lock(mTracksMutex); // read-only
 	if (auto it = mTracksBySsrc.find(ssrc); it != mTracksBySsrc.end()) {
-		if (auto track = it->second.lock())
-			track->incoming(message);
+		if (auto track = it->second.lock()) {
+			if (config.enableMediaPipelining)
+				track->enqueueIncoming(message);
+			else
+				track->incoming(message);
+		}
 	} else {
 		/*
 		 * TODO: So the problem is that when stop sending streams, we stop getting report blocks for
@@ -590,6 +691,12 @@ void PeerConnection::forwardBufferedAmount(uint16_t stream, size_t amount) {
 }
 
 shared_ptr<DataChannel> PeerConnection::emplaceDataChannel(string label, DataChannelInit init) {
+	const auto &reliability = init.reliability;
+	if (reliability.latestOnly && !reliability.unordered &&
+	    reliability.type == Reliability::Type::Reliable)
+		throw std::invalid_argument(
+		    "Latest-only policy requires an unordered or partially reliable DataChannel");
+
 	std::unique_lock lock(mDataChannelsMutex); // we are going to emplace
 
 	// If the DataChannel is user-negotiated, do not negotiate it in-band
@@ -976,6 +1083,7 @@ void PeerConnection::processLocalDescription(Description description) {
 
 	updateTrackSsrcCache(description);
 
+	std::vector<Candidate> prewarmedCandidates;
 	{
 		// Set as local description
 		std::lock_guard lock(mLocalDescriptionMutex);
@@ -986,6 +1094,15 @@ void PeerConnection::processLocalDescription(Description description) {
 			mCurrentLocalDescription.emplace(std::move(*mLocalDescription));
 		}
 
+		// Candidates gathered on prewarm are part of the first local description
+		prewarmedCandidates = std::exchange(mPrewarmedCandidates, {});
+		for (auto &candidate : prewarmedCandidates) {
+			candidate.hintMid(description.bundleMid());
+			description.addCandidate(candidate);
+		}
+		if (std::exchange(mPrewarmedCandidatesEnded, false))
+			description.endCandidates();
+
 		mLocalDescription.emplace(description);
 		mLocalDescription->addCandidates(std::move(existingCandidates));
 	}
@@ -993,6 +1110,10 @@ void PeerConnection::processLocalDescription(Description description) {
 	mProcessor.enqueue(&PeerConnection::trigger<Description>, shared_from_this(),
 	                   &localDescriptionCallback, std::move(description));
 
+	for (auto &candidate : prewarmedCandidates)
+		mProcessor.enqueue(&PeerConnection::trigger<Candidate>, shared_from_this(),
+		                   &localCandidateCallback, std::move(candidate));
+
 	// Reciprocated tracks might need to be open
 	if (auto dtlsTransport = std::atomic_load(&mDtlsTransport);
 	    dtlsTransport && dtlsTransport->state() == Transport::State::Connected)
@@ -1001,18 +1122,24 @@ void PeerConnection::processLocalDescription(Description description) {
 
 void PeerConnection::processLocalCandidate(Candidate candidate) {
 	std::lock_guard lock(mLocalDescriptionMutex);
-	if (!mLocalDescription)
-		throw std::logic_error("Got a local candidate without local description");
-
 	if (config.iceTransportPolicy == TransportPolicy::Relay &&
 	    candidate.type() != Candidate::Type::Relayed) {
 		PLOG_VERBOSE << "Not issuing local candidate because of transport policy: " << candidate;
 		return;
 	}
 
+	candidate.resolve(Candidate::ResolveMode::Simple);
+
+	if (!mLocalDescription) {
+		// Gathered on prewarm, the candidate is issued with the first local description
+		PLOG_VERBOSE << "Buffering local candidate: " << candidate;
+		mPrewarmedCandidates.push_back(std::move(candidate));
+		return;
+	}
+
 	PLOG_VERBOSE << "Issuing local candidate: " << candidate;
 
-	candidate.resolve(Candidate::ResolveMode::Simple);
+	candidate.hintMid(mLocalDescription->bundleMid());
 	mLocalDescription->addCandidate(candidate);
 
 	mProcessor.enqueue(&PeerConnection::trigger<Candidate>, shared_from_this(),
@@ -1069,17 +1196,15 @@ void PeerConnection::processRemoteCandidate(Candidate candidate) {
 	if (candidate.isResolved()) {
 		iceTransport->addRemoteCandidate(std::move(candidate));
 	} else {
-		// We might need a lookup, do it asynchronously
+		// We might need a lookup, do it asynchronously on the resolver threads
 		// We don't use the thread pool because we have no control on the timeout
 		if ((iceTransport = std::atomic_load(&mIceTransport))) {
 			weak_ptr<IceTransport> weakIceTransport{iceTransport};
-			std::thread t([weakIceTransport, candidate = std::move(candidate)]() mutable {
-				utils::this_thread::set_name("RTC resolver");
-				if (candidate.resolve(Candidate::ResolveMode::Lookup))
+			candidate.resolveAsync([weakIceTransport](optional<Candidate> resolved) {
+				if (resolved)
 					if (auto iceTransport = weakIceTransport.lock())
-						iceTransport->addRemoteCandidate(std::move(candidate));
+						iceTransport->addRemoteCandidate(std::move(*resolved));
 			});
-			t.detach();
 		}
 	}
 }
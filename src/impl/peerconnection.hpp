@@ -38,12 +38,16 @@ struct PeerConnection : std::enable_shared_from_this<PeerConnection> {
 
 	void close();
 	void remoteClose();
+	// Set up the ICE transport and gather candidates before negotiation, returns false if the
+	// certificate is still pending
+	bool prewarm();
 
 	optional<Description> localDescription() const;
 	optional<Description> remoteDescription() const;
 	size_t remoteMaxMessageSize() const;
 
 	shared_ptr<IceTransport> initIceTransport();
+	shared_ptr<IceTransport> restartIceTransport();
 	shared_ptr<DtlsTransport> initDtlsTransport();
 	shared_ptr<SctpTransport> initSctpTransport();
 	shared_ptr<IceTransport> getIceTransport() const;
@@ -53,6 +57,7 @@ struct PeerConnection : std::enable_shared_from_this<PeerConnection> {
 
 	void endLocalCandidates();
 	void rollbackLocalDescription();
+	bool isIceRestart(const Description &description) const;
 	bool checkFingerprint(const std::string &fingerprint) const;
 	void forwardMessage(message_ptr message);
 	void forwardMedia(message_ptr message);
@@ -128,6 +133,7 @@ struct PeerConnection : std::enable_shared_from_this<PeerConnection> {
 
 private:
 	void updateTrackSsrcCache(const Description &description);
+	void completeIceRestart();
 
 	const init_token mInitToken = Init::Instance().token();
 	const future_certificate_ptr mCertificate;
@@ -137,11 +143,16 @@ private:
 	optional<Description> mCurrentLocalDescription;
 	mutable std::mutex mLocalDescriptionMutex, mRemoteDescriptionMutex;
 
+	// Candidates gathered on prewarm before the first local description
+	std::vector<Candidate> mPrewarmedCandidates; // under mLocalDescriptionMutex
+	bool mPrewarmedCandidatesEnded = false;      // under mLocalDescriptionMutex
+
 	shared_ptr<MediaHandler> mMediaHandler;
 
 	mutable std::shared_mutex mMediaHandlerMutex;
 
 	shared_ptr<IceTransport> mIceTransport;
+	std::atomic<unsigned int> mIceGeneration = 0; // incremented on ICE restart
 	shared_ptr<DtlsTransport> mDtlsTransport;
 	shared_ptr<SctpTransport> mSctpTransport;
 
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "peerconnectionpool.hpp"
+#include "internals.hpp"
+#include "threadpool.hpp"
+
+#include <chrono>
+#include <utility>
+
+namespace rtc::impl {
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+PeerConnectionPool::PeerConnectionPool(Configuration config_, size_t size_)
+    : config(std::move(config_)), size(size_) {
+	PLOG_VERBOSE << "Creating PeerConnection pool, size=" << size;
+}
+
+PeerConnectionPool::~PeerConnectionPool() {
+	PLOG_VERBOSE << "Destroying PeerConnection pool";
+	close();
+}
+
+void PeerConnectionPool::start() { enqueueRefill(); }
+
+void PeerConnectionPool::close() {
+	if (mClosed.exchange(true))
+		return;
+
+	std::deque<shared_ptr<PeerConnection>> pool;
+	{
+		std::lock_guard lock(mMutex);
+		std::swap(pool, mPool);
+		if (mWarming)
+			pool.push_back(std::exchange(mWarming, nullptr));
+	}
+
+	for (auto &pc : pool)
+		pc->remoteClose();
+}
+
+shared_ptr<PeerConnection> PeerConnectionPool::acquire() {
+	if (mClosed)
+		throw std::logic_error("PeerConnection pool is closed");
+
+	auto startTime = steady_clock::now();
+
+	shared_ptr<PeerConnection> pc;
+	{
+		std::lock_guard lock(mMutex);
+		// Discard pooled PeerConnections which were closed in the meantime
+		while (!pc && !mPool.empty()) {
+			pc = std::move(mPool.front());
+			mPool.pop_front();
+			if (pc->closing || pc->state != PeerConnection::State::New)
+				pc.reset();
+		}
+	}
+
+	if (pc) {
+		++hits;
+	} else {
+		PLOG_DEBUG << "PeerConnection pool is empty";
+		++misses;
+		pc = std::make_shared<PeerConnection>(config);
+	}
+
+	enqueueRefill();
+
+	int64_t elapsed = duration_cast<microseconds>(steady_clock::now() - startTime).count();
+	totalAcquireTime += elapsed;
+	int64_t max = maxAcquireTime.load();
+	while (elapsed > max && !maxAcquireTime.compare_exchange_weak(max, elapsed))
+		;
+
+	return pc;
+}
+
+size_t PeerConnectionPool::available() const {
+	std::lock_guard lock(mMutex);
+	return mPool.size();
+}
+
+void PeerConnectionPool::clearStats() {
+	hits = 0;
+	misses = 0;
+	totalAcquireTime = 0;
+	maxAcquireTime = 0;
+}
+
+void PeerConnectionPool::enqueueRefill() {
+	if (mClosed || mPendingRefill.exchange(true))
+		return;
+
+	ThreadPool::Instance().enqueue(weak_bind(&PeerConnectionPool::refill, this));
+}
+
+void PeerConnectionPool::refill() {
+	try {
+		while (!mClosed && available() < size) {
+			std::unique_lock lock(mMutex);
+			auto pc = std::exchange(mWarming, nullptr);
+			lock.unlock();
+
+			// Creating a PeerConnection can take a while, so the lock is not held meanwhile
+			if (!pc)
+				pc = std::make_shared<PeerConnection>(config);
+
+			// Waiting for the certificate would block a worker of the thread pool which might be
+			// needed to generate it, so the PeerConnection is set aside and checked again later
+			bool ready = pc->prewarm();
+
+			lock.lock();
+			if (mClosed) {
+				lock.unlock();
+				pc->remoteClose();
+				break;
+			}
+
+			if (!ready) {
+				mWarming = std::move(pc);
+				ThreadPool::Instance().schedule(PEER_CONNECTION_POOL_RETRY_INTERVAL,
+				                                weak_bind(&PeerConnectionPool::refill, this));
+				return; // the refill is still pending
+			}
+
+			mPool.push_back(std::move(pc));
+		}
+
+	} catch (const std::exception &e) {
+		PLOG_WARNING << "Failed to refill PeerConnection pool: " << e.what();
+		mPendingRefill = false;
+		return;
+	}
+
+	mPendingRefill = false;
+
+	// A PeerConnection might have been acquired after the last check, while the refill was still
+	// marked as pending
+	if (!mClosed && available() < size)
+		enqueueRefill();
+}
+
+} // namespace rtc::impl
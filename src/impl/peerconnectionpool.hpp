@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_PEER_CONNECTION_POOL_H
+#define RTC_IMPL_PEER_CONNECTION_POOL_H
+
+#include "common.hpp"
+#include "init.hpp"
+#include "peerconnection.hpp"
+
+#include "rtc/peerconnectionpool.hpp"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace rtc::impl {
+
+struct PeerConnectionPool final : public std::enable_shared_from_this<PeerConnectionPool> {
+	PeerConnectionPool(Configuration config_, size_t size_);
+	~PeerConnectionPool();
+
+	void start();
+	void close();
+
+	shared_ptr<PeerConnection> acquire();
+	size_t available() const;
+	void clearStats();
+
+	const Configuration config;
+	const size_t size;
+
+	// Stats
+	std::atomic<size_t> hits = 0, misses = 0;
+	std::atomic<int64_t> totalAcquireTime = 0, maxAcquireTime = 0; // microseconds
+
+private:
+	const init_token mInitToken = Init::Instance().token();
+
+	void enqueueRefill();
+	void refill();
+
+	std::deque<shared_ptr<PeerConnection>> mPool;
+	shared_ptr<PeerConnection> mWarming; // waiting for its certificate
+	mutable std::mutex mMutex;
+	std::atomic<bool> mPendingRefill = false;
+	std::atomic<bool> mClosed = false;
+};
+
+} // namespace rtc::impl
+
+#endif
@@ -11,11 +11,13 @@
 
 #include "common.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <mutex>
-#include <queue>
 
 namespace rtc::impl {
 
@@ -36,11 +38,12 @@ public:
 	optional<T> pop();
 	optional<T> peek();
 	optional<T> exchange(T element);
+	optional<T> replace(T element, std::function<bool(const T &)> pred);
 
 private:
 	const size_t mLimit;
 	size_t mAmount;
-	std::queue<T> mQueue;
+	std::deque<T> mQueue;
 	std::condition_variable mPushCondition;
 	amount_function mAmountFunction;
 	bool mStopping = false;
@@ -96,7 +99,7 @@ template <typename T> void Queue<T>::push(T element) {
 		return;
 
 	mAmount += mAmountFunction(element);
-	mQueue.emplace(std::move(element));
+	mQueue.emplace_back(std::move(element));
 }
 
 template <typename T> optional<T> Queue<T>::pop() {
@@ -106,7 +109,7 @@ template <typename T> optional<T> Queue<T>::pop() {
 
 	mAmount -= mAmountFunction(mQueue.front());
 	optional<T> element{std::move(mQueue.front())};
-	mQueue.pop();
+	mQueue.pop_front();
 	return element;
 }
 
@@ -124,6 +127,20 @@ template <typename T> optional<T> Queue<T>::exchange(T element) {
 	return std::make_optional(std::move(element));
 }
 
+template <typename T>
+optional<T> Queue<T>::replace(T element, std::function<bool(const T &)> pred) {
+	std::unique_lock lock(mMutex);
+	// Replace the most recent matching element in place
+	auto it = std::find_if(mQueue.rbegin(), mQueue.rend(), pred);
+	if (it == mQueue.rend())
+		return nullopt;
+
+	mAmount -= mAmountFunction(*it);
+	mAmount += mAmountFunction(element);
+	std::swap(*it, element);
+	return std::make_optional(std::move(element));
+}
+
 } // namespace rtc::impl
 
 #endif
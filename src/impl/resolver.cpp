@@ -0,0 +1,249 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "resolver.hpp"
+#include "utils.hpp"
+
+#include <cstring>
+
+namespace rtc::impl {
+
+Resolver &Resolver::Instance() {
+	static Resolver *instance = new Resolver;
+	return *instance;
+}
+
+Resolver::Resolver() {}
+
+Resolver::~Resolver() {}
+
+void Resolver::start() {
+	std::lock_guard lock(mMutex);
+	mJoining = false;
+	for (int i = int(mWorkers.size()); i < RESOLVER_THREADS_COUNT; ++i)
+		mWorkers.emplace_back(std::bind(&Resolver::run, this));
+}
+
+void Resolver::join() {
+	std::vector<std::thread> workers;
+	{
+		std::lock_guard lock(mMutex);
+		mJoining = true;
+		mCondition.notify_all();
+		workers = std::move(mWorkers);
+		mWorkers.clear();
+	}
+
+	for (auto &w : workers)
+		w.join();
+
+	std::map<Key, std::vector<resolve_callback>> pending;
+	{
+		std::lock_guard lock(mMutex);
+		mQueue.clear();
+		std::swap(pending, mPending);
+	}
+
+	// Lookups which did not complete are reported as failed
+	for (auto &[key, callbacks] : pending) {
+		for (auto &callback : callbacks) {
+			try {
+				callback(nullopt);
+			} catch (const std::exception &e) {
+				PLOG_WARNING << e.what();
+			}
+		}
+	}
+}
+
+void Resolver::clear() {
+	std::lock_guard lock(mMutex);
+	mCache.clear();
+}
+
+optional<Resolver::address_list> Resolver::Numeric(string hostname, string service,
+                                                   int socktype) {
+	return GetAddrInfo(Key(std::move(hostname), std::move(service), socktype), true);
+}
+
+void Resolver::resolve(string hostname, string service, int socktype,
+                       resolve_callback callback) {
+	Key key(std::move(hostname), std::move(service), socktype);
+	if (auto addresses = GetAddrInfo(key, true)) {
+		if (callback)
+			callback(std::move(addresses));
+		return;
+	}
+
+	std::unique_lock lock(mMutex);
+	if (auto entry = find(key)) {
+		auto addresses = entry->addresses;
+		lock.unlock();
+		if (callback)
+			callback(std::move(addresses));
+		return;
+	}
+
+	if (mWorkers.empty()) {
+		// Not started, fall back to synchronous resolution
+		lock.unlock();
+		auto addresses = resolve(std::get<0>(key), std::get<1>(key), socktype);
+		if (callback)
+			callback(std::move(addresses));
+		return;
+	}
+
+	// Concurrent requests for the same name share a single lookup
+	auto [it, inserted] = mPending.try_emplace(key);
+	if (callback)
+		it->second.emplace_back(std::move(callback));
+
+	if (inserted) {
+		mQueue.emplace_back(std::move(key));
+		mCondition.notify_one();
+	}
+}
+
+optional<Resolver::address_list> Resolver::resolve(string hostname, string service,
+                                                   int socktype) {
+	Key key(std::move(hostname), std::move(service), socktype);
+	if (auto addresses = GetAddrInfo(key, true))
+		return addresses;
+
+	{
+		std::lock_guard lock(mMutex);
+		if (auto entry = find(key))
+			return entry->addresses;
+	}
+
+	PLOG_DEBUG << "Resolving " << std::get<0>(key) << ":" << std::get<1>(key);
+	auto addresses = GetAddrInfo(key, false);
+
+	std::lock_guard lock(mMutex);
+	store(key, addresses);
+	return addresses;
+}
+
+optional<Resolver::address_list> Resolver::lookup(string hostname, string service, int socktype) {
+	Key key(std::move(hostname), std::move(service), socktype);
+	if (auto addresses = GetAddrInfo(key, true))
+		return addresses;
+
+	std::lock_guard lock(mMutex);
+	if (auto entry = find(key))
+		return entry->addresses;
+
+	return nullopt;
+}
+
+optional<Resolver::address_list> Resolver::GetAddrInfo(const Key &key, bool numeric) {
+	const auto &[hostname, service, socktype] = key;
+
+	struct addrinfo hints = {};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = socktype;
+	if (socktype == SOCK_DGRAM)
+		hints.ai_protocol = IPPROTO_UDP;
+	else if (socktype == SOCK_STREAM)
+		hints.ai_protocol = IPPROTO_TCP;
+
+	hints.ai_flags = AI_ADDRCONFIG;
+	if (numeric)
+		hints.ai_flags |= AI_NUMERICHOST;
+
+	struct addrinfo *result = nullptr;
+	if (getaddrinfo(hostname.c_str(), service.c_str(), &hints, &result) != 0)
+		return nullopt;
+
+	address_list addresses;
+	for (auto ai = result; ai; ai = ai->ai_next) {
+		if (ai->ai_family != AF_INET && ai->ai_family != AF_INET6)
+			continue;
+
+		struct sockaddr_storage addr = {};
+		std::memcpy(&addr, ai->ai_addr, ai->ai_addrlen);
+		addresses.emplace_back(addr, socklen_t(ai->ai_addrlen));
+	}
+
+	freeaddrinfo(result);
+
+	if (addresses.empty())
+		return nullopt;
+
+	return addresses;
+}
+
+const Resolver::Entry *Resolver::find(const Key &key) {
+	auto it = mCache.find(key);
+	if (it == mCache.end())
+		return nullptr;
+
+	if (it->second.expiry <= clock::now()) {
+		mCache.erase(it);
+		return nullptr;
+	}
+
+	return &it->second;
+}
+
+void Resolver::store(const Key &key, optional<address_list> addresses) {
+	auto now = clock::now();
+	auto it = mCache.begin();
+	while (it != mCache.end()) {
+		if (it->second.expiry <= now)
+			it = mCache.erase(it);
+		else
+			++it;
+	}
+
+	// getaddrinfo() does not expose record TTLs, so entries are kept for a bounded duration
+	auto ttl = addresses ? RESOLVER_CACHE_TTL : RESOLVER_NEGATIVE_CACHE_TTL;
+	mCache[key] = Entry{std::move(addresses), now + ttl};
+}
+
+void Resolver::run() {
+	utils::this_thread::set_name("RTC resolver");
+
+	std::unique_lock lock(mMutex);
+	while (true) {
+		mCondition.wait(lock, [this]() { return mJoining || !mQueue.empty(); });
+		if (mJoining)
+			break;
+
+		Key key = std::move(mQueue.front());
+		mQueue.pop_front();
+		lock.unlock();
+
+		PLOG_DEBUG << "Resolving " << std::get<0>(key) << ":" << std::get<1>(key);
+		auto addresses = GetAddrInfo(key, false);
+		if (!addresses)
+			PLOG_WARNING << "Resolution failed for \"" << std::get<0>(key) << ":"
+			             << std::get<1>(key) << "\"";
+
+		lock.lock();
+		store(key, addresses);
+		std::vector<resolve_callback> callbacks;
+		if (auto it = mPending.find(key); it != mPending.end()) {
+			callbacks = std::move(it->second);
+			mPending.erase(it);
+		}
+		lock.unlock();
+
+		for (auto &callback : callbacks) {
+			try {
+				callback(addresses);
+			} catch (const std::exception &e) {
+				PLOG_WARNING << e.what();
+			}
+		}
+
+		lock.lock();
+	}
+}
+
+} // namespace rtc::impl
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_RESOLVER_H
+#define RTC_IMPL_RESOLVER_H
+
+#include "common.hpp"
+#include "internals.hpp"
+#include "socket.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace rtc::impl {
+
+// Name resolution with a cache shared by all connections. Lookups run on dedicated threads so a
+// slow resolver does not hold up the thread pool.
+class Resolver final {
+public:
+	using clock = std::chrono::steady_clock;
+	using address_list = std::vector<std::tuple<struct sockaddr_storage, socklen_t>>;
+	using resolve_callback = std::function<void(optional<address_list> addresses)>;
+
+	static Resolver &Instance();
+
+	Resolver(const Resolver &) = delete;
+	Resolver &operator=(const Resolver &) = delete;
+	Resolver(Resolver &&) = delete;
+	Resolver &operator=(Resolver &&) = delete;
+
+	void start();
+	void join();
+	void clear();
+
+	// Parse a numeric host, never resolves
+	static optional<address_list> Numeric(string hostname, string service, int socktype);
+
+	// Resolve in the background, the callback is called immediately on cache hit. A null callback
+	// only fills the cache.
+	void resolve(string hostname, string service, int socktype, resolve_callback callback);
+
+	// Resolve synchronously, served from the cache if possible
+	optional<address_list> resolve(string hostname, string service, int socktype);
+
+	// Return the cached addresses if any, without resolving
+	optional<address_list> lookup(string hostname, string service, int socktype);
+
+private:
+	Resolver();
+	~Resolver();
+
+	using Key = std::tuple<string, string, int>;
+
+	struct Entry {
+		optional<address_list> addresses; // nullopt if resolution failed
+		clock::time_point expiry;
+	};
+
+	static optional<address_list> GetAddrInfo(const Key &key, bool numeric);
+
+	const Entry *find(const Key &key); // mMutex must be locked
+	void store(const Key &key, optional<address_list> addresses); // same
+	void run();
+
+	std::map<Key, Entry> mCache;
+	std::map<Key, std::vector<resolve_callback>> mPending;
+	std::deque<Key> mQueue;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+
+	std::vector<std::thread> mWorkers;
+	bool mJoining = false;
+};
+
+} // namespace rtc::impl
+
+#endif
@@ -19,7 +19,6 @@
 #include <iostream>
 #include <limits>
 #include <shared_mutex>
-#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -72,6 +71,10 @@ template <typename T> uint32_t to_uint32(T i) {
 
 namespace rtc::impl {
 
+const auto SCTP_TIMER_INTERVAL = 10ms;        // usrsctp timer granularity
+const auto SCTP_TIMER_IDLE_DURATION = 1000ms; // keep ticking after the last transport is gone
+const int SCTP_CLEANUP_MAX_STEPS = 600;       // give up after 10 minutes of simulated time
+
 static LogCounter COUNTER_UNKNOWN_PPID(plog::warning,
                                        "Number of SCTP packets received with an unknown PPID");
 
@@ -100,8 +103,68 @@ private:
 
 SctpTransport::InstancesSet *SctpTransport::Instances = new InstancesSet;
 
+// usrsctp is initialized without its own timer thread, which would wake up every 10ms for the whole
+// lifetime of the process. Instead, timers are driven from the thread pool, and only while there is
+// at least one SCTP transport, or a closed socket which might still need timers to be released.
+class SctpTransport::TimerScheduler {
+public:
+	void acquire() {
+		std::unique_lock lock(mMutex);
+		++mCount;
+		if (!std::exchange(mScheduled, true)) {
+			mLastTick = clock::now();
+			schedule();
+		}
+	}
+
+	void release() {
+		std::unique_lock lock(mMutex);
+		if (--mCount == 0)
+			mIdleSince = clock::now();
+	}
+
+	void reset() {
+		// Thread pool must be joined
+		std::unique_lock lock(mMutex);
+		mScheduled = false;
+	}
+
+private:
+	using clock = ThreadPool::clock;
+
+	void schedule() {
+		// mMutex needs to be locked
+		ThreadPool::Instance().schedule(SCTP_TIMER_INTERVAL, [this]() { tick(); });
+	}
+
+	void tick() {
+		std::unique_lock lock(mMutex);
+		auto now = clock::now();
+		auto elapsed = duration_cast<milliseconds>(now - mLastTick);
+		mLastTick += elapsed;
+		lock.unlock();
+
+		if (elapsed.count() > 0)
+			usrsctp_handle_timers(to_uint32(elapsed.count()));
+
+		lock.lock();
+		if (mCount > 0 || now - mIdleSince < SCTP_TIMER_IDLE_DURATION)
+			schedule();
+		else
+			mScheduled = false;
+	}
+
+	int mCount = 0;
+	bool mScheduled = false;
+	clock::time_point mLastTick;
+	clock::time_point mIdleSince;
+	std::mutex mMutex;
+};
+
+SctpTransport::TimerScheduler *SctpTransport::Timers = new TimerScheduler;
+
 void SctpTransport::Init() {
-	usrsctp_init(0, SctpTransport::WriteCallback, SctpTransport::DebugCallback);
+	usrsctp_init_nothreads(0, SctpTransport::WriteCallback, SctpTransport::DebugCallback);
 	usrsctp_enable_crc32c_offload();       // We'll compute CRC32 only for outgoing packets
 	usrsctp_sysctl_set_sctp_pr_enable(1);  // Enable Partial Reliability Extension (RFC 3758)
 	usrsctp_sysctl_set_sctp_ecn_enable(0); // Disable Explicit Congestion Notification
@@ -160,8 +223,17 @@ void SctpTransport::SetSettings(const SctpSettings &s) {
 }
 
 void SctpTransport::Cleanup() {
-	while (usrsctp_finish())
-		std::this_thread::sleep_for(100ms);
+	// The thread pool is joined, so timers are not ticking anymore. Closed sockets are only
+	// released by timers, therefore we fire them manually instead of waiting for them to expire.
+	Timers->reset();
+	int steps = 0;
+	while (usrsctp_finish()) {
+		if (++steps > SCTP_CLEANUP_MAX_STEPS) {
+			PLOG_WARNING << "SCTP cleanup did not complete";
+			break;
+		}
+		usrsctp_handle_timers(to_uint32(SCTP_TIMER_IDLE_DURATION.count()));
+	}
 }
 
 SctpTransport::SctpTransport(shared_ptr<Transport> lower, const Configuration &config, Ports ports,
@@ -310,6 +382,7 @@ SctpTransport::SctpTransport(shared_ptr<Transport> lower, const Configuration &c
 
 	usrsctp_register_address(this);
 	Instances->insert(this);
+	Timers->acquire();
 }
 
 SctpTransport::~SctpTransport() {
@@ -328,6 +401,7 @@ SctpTransport::~SctpTransport() {
 
 	usrsctp_deregister_address(this);
 	Instances->erase(this);
+	Timers->release();
 }
 
 void SctpTransport::onBufferedAmount(amount_callback callback) {
@@ -387,6 +461,14 @@ bool SctpTransport::send(message_ptr message) {
 	if (trySendQueue() && trySendMessage(message))
 		return true;
 
+	// With the latest-only policy, supersede the pending message instead of queueing behind it
+	// Reliable ordered delivery must never drop messages, so the policy is ignored in that case
+	const auto &reliability = message->reliability;
+	if (reliability && reliability->latestOnly &&
+	    (reliability->unordered || reliability->type != Reliability::Type::Reliable) &&
+	    tryReplaceMessage(message))
+		return false;
+
 	mSendQueue.push(message);
 	updateBufferedAmount(to_uint16(message->stream), ptrdiff_t(message_size_func(message)));
 	return false;
@@ -437,6 +519,18 @@ void SctpTransport::close() {
 	}
 }
 
+void SctpTransport::pauseRecv() {
+	if (mRecvPauseCount++ == 0)
+		PLOG_VERBOSE << "SCTP receiving paused";
+}
+
+void SctpTransport::resumeRecv() {
+	if (--mRecvPauseCount == 0) {
+		PLOG_VERBOSE << "SCTP receiving resumed";
+		enqueueRecv();
+	}
+}
+
 unsigned int SctpTransport::maxStream() const {
 	unsigned int streamsCount = mNegotiatedStreamsCount.value_or(MAX_SCTP_STREAMS_COUNT);
 	return streamsCount > 0 ? streamsCount - 1 : 0;
@@ -463,14 +557,10 @@ void SctpTransport::incoming(message_ptr message) {
 
 	PLOG_VERBOSE << "Incoming size=" << message->size();
 
-	usrsctp_conninput(this, message->data(), message->size(), 0);
-}
+	if (message->arrivalTime)
+		mLastArrivalTime = *message->arrivalTime;
 
-bool SctpTransport::outgoing(message_ptr message) {
-	// Set recommended medium-priority DSCP value
-	// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
-	message->dscp = 10; // AF11: Assured Forwarding class 1, low drop probability
-	return Transport::outgoing(std::move(message));
+	usrsctp_conninput(this, message->data(), message->size(), 0);
 }
 
 void SctpTransport::doRecv() {
@@ -478,6 +568,9 @@ void SctpTransport::doRecv() {
 	--mPendingRecvCount;
 	try {
 		while (state() != State::Disconnected && state() != State::Failed) {
+			if (mRecvPauseCount > 0)
+				break; // Reading will be resumed by resumeRecv()
+
 			const size_t bufferSize = 65536;
 			byte buffer[bufferSize];
 			socklen_t fromlen = 0;
@@ -680,6 +773,22 @@ bool SctpTransport::trySendMessage(message_ptr message) {
 	return true;
 }
 
+bool SctpTransport::tryReplaceMessage(message_ptr message) {
+	// Requires mSendMutex to be locked
+	const auto stream = message->stream;
+	auto previous = mSendQueue.replace(message, [stream](const message_ptr &m) {
+		return m->stream == stream && (m->type == Message::Binary || m->type == Message::String);
+	});
+	if (!previous)
+		return false;
+
+	PLOG_VERBOSE << "SCTP superseded pending message on stream " << stream;
+	++mMessagesSuperseded;
+	updateBufferedAmount(to_uint16(stream), ptrdiff_t(message_size_func(message)) -
+	                                            ptrdiff_t(message_size_func(*previous)));
+	return true;
+}
+
 void SctpTransport::updateBufferedAmount(uint16_t streamId, ptrdiff_t delta) {
 	// Requires mSendMutex to be locked
 
@@ -755,7 +864,12 @@ int SctpTransport::handleWrite(byte *data, size_t len, uint8_t /*tos*/,
 		std::unique_lock lock(mWriteMutex);
 		PLOG_VERBOSE << "Handle write, len=" << len;
 
-		if (!outgoing(make_message(data, data + len)))
+		// Set recommended medium-priority DSCP value
+		// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
+		const unsigned int dscp = 10; // AF11: Assured Forwarding class 1, low drop probability
+
+		// The packet is encrypted synchronously by the DTLS transport, so it is not copied here
+		if (!outgoingBuffer(data, len, dscp))
 			return -1;
 
 		mWritten = true;
@@ -779,7 +893,7 @@ void SctpTransport::processData(binary &&data, uint16_t sid, PayloadId ppid) {
 	// We handle those PPIDs at reception for compatibility reasons but shall never send them.
 	switch (ppid) {
 	case PPID_CONTROL:
-		recv(make_message(std::move(data), Message::Control, sid));
+		recvData(make_message(std::move(data), Message::Control, sid));
 		break;
 
 	case PPID_STRING_PARTIAL: // deprecated
@@ -790,19 +904,19 @@ void SctpTransport::processData(binary &&data, uint16_t sid, PayloadId ppid) {
 	case PPID_STRING:
 		if (mPartialStringData.empty()) {
 			mBytesReceived += data.size();
-			recv(make_message(std::move(data), Message::String, sid));
+			recvData(make_message(std::move(data), Message::String, sid));
 		} else {
 			mPartialStringData.insert(mPartialStringData.end(), data.begin(), data.end());
 			mPartialStringData.resize(mMaxMessageSize);
 			mBytesReceived += mPartialStringData.size();
 			auto message = make_message(std::move(mPartialStringData), Message::String, sid);
 			mPartialStringData.clear();
-			recv(std::move(message));
+			recvData(std::move(message));
 		}
 		break;
 
 	case PPID_STRING_EMPTY:
-		recv(make_message(std::move(mPartialStringData), Message::String, sid));
+		recvData(make_message(std::move(mPartialStringData), Message::String, sid));
 		mPartialStringData.clear();
 		break;
 
@@ -814,19 +928,19 @@ void SctpTransport::processData(binary &&data, uint16_t sid, PayloadId ppid) {
 	case PPID_BINARY:
 		if (mPartialBinaryData.empty()) {
 			mBytesReceived += data.size();
-			recv(make_message(std::move(data), Message::Binary, sid));
+			recvData(make_message(std::move(data), Message::Binary, sid));
 		} else {
 			mPartialBinaryData.insert(mPartialBinaryData.end(), data.begin(), data.end());
 			mPartialBinaryData.resize(mMaxMessageSize);
 			mBytesReceived += mPartialBinaryData.size();
 			auto message = make_message(std::move(mPartialBinaryData), Message::Binary, sid);
 			mPartialBinaryData.clear();
-			recv(std::move(message));
+			recvData(std::move(message));
 		}
 		break;
 
 	case PPID_BINARY_EMPTY:
-		recv(make_message(std::move(mPartialBinaryData), Message::Binary, sid));
+		recvData(make_message(std::move(mPartialBinaryData), Message::Binary, sid));
 		mPartialBinaryData.clear();
 		break;
 
@@ -838,6 +952,15 @@ void SctpTransport::processData(binary &&data, uint16_t sid, PayloadId ppid) {
 	}
 }
 
+void SctpTransport::recvData(message_ptr message) {
+	// A message is stamped with the arrival time of the last packet passed to usrsctp, which
+	// completes it in the usual case
+	if (auto arrivalTime = mLastArrivalTime.load(); arrivalTime != clock::time_point())
+		message->arrivalTime = arrivalTime;
+
+	recv(std::move(message));
+}
+
 void SctpTransport::processNotification(const union sctp_notification *notify, size_t len) {
 	if (len != size_t(notify->sn_header.sn_length)) {
 		PLOG_WARNING << "Unexpected notification length, expected=" << notify->sn_header.sn_length
@@ -932,12 +1055,15 @@ void SctpTransport::processNotification(const union sctp_notification *notify, s
 void SctpTransport::clearStats() {
 	mBytesReceived = 0;
 	mBytesSent = 0;
+	mMessagesSuperseded = 0;
 }
 
 size_t SctpTransport::bytesSent() { return mBytesSent; }
 
 size_t SctpTransport::bytesReceived() { return mBytesReceived; }
 
+size_t SctpTransport::messagesSuperseded() { return mMessagesSuperseded; }
+
 optional<milliseconds> SctpTransport::rtt() {
 	if (state() != State::Connected)
 		return nullopt;
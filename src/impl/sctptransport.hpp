@@ -16,6 +16,7 @@
 #include "queue.hpp"
 #include "transport.hpp"
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <map>
@@ -31,6 +32,7 @@ public:
 	static void SetSettings(const SctpSettings &s);
 	static void Cleanup();
 
+	using clock = std::chrono::steady_clock;
 	using amount_callback = std::function<void(uint16_t streamId, size_t amount)>;
 
 	struct Ports {
@@ -52,12 +54,18 @@ public:
 	void closeStream(unsigned int stream);
 	void close();
 
+	// Receive-side flow control: while paused, messages are left in the SCTP receive buffer so the
+	// advertised receiver window shrinks and the remote sender slows down.
+	void pauseRecv();
+	void resumeRecv();
+
 	unsigned int maxStream() const;
 
 	// Stats
 	void clearStats();
 	size_t bytesSent();
 	size_t bytesReceived();
+	size_t messagesSuperseded();
 	optional<std::chrono::milliseconds> rtt();
 
 private:
@@ -78,7 +86,6 @@ private:
 	void connect();
 	void shutdown();
 	void incoming(message_ptr message) override;
-	bool outgoing(message_ptr message) override;
 
 	void doRecv();
 	void doFlush();
@@ -86,6 +93,7 @@ private:
 	void enqueueFlush();
 	bool trySendQueue();
 	bool trySendMessage(message_ptr message);
+	bool tryReplaceMessage(message_ptr message);
 	void updateBufferedAmount(uint16_t streamId, ptrdiff_t delta);
 	void triggerBufferedAmount(uint16_t streamId, size_t amount);
 	void sendReset(uint16_t streamId);
@@ -94,6 +102,7 @@ private:
 	int handleWrite(byte *data, size_t len, uint8_t tos, uint8_t set_df) noexcept;
 
 	void processData(binary &&data, uint16_t streamId, PayloadId ppid);
+	void recvData(message_ptr message);
 	void processNotification(const union sctp_notification *notify, size_t len);
 
 	const size_t mMaxMessageSize;
@@ -104,6 +113,8 @@ private:
 	Processor mProcessor;
 	std::atomic<int> mPendingRecvCount = 0;
 	std::atomic<int> mPendingFlushCount = 0;
+	std::atomic<int> mRecvPauseCount = 0;
+	std::atomic<clock::time_point> mLastArrivalTime = clock::time_point(); // epoch if unknown
 	std::mutex mRecvMutex;
 	std::recursive_mutex mSendMutex; // buffered amount callback is synchronous
 	Queue<message_ptr> mSendQueue;
@@ -121,6 +132,7 @@ private:
 
 	// Stats
 	std::atomic<size_t> mBytesSent = 0, mBytesReceived = 0;
+	std::atomic<size_t> mMessagesSuperseded = 0;
 
 	static void UpcallCallback(struct socket *sock, void *arg, int flags);
 	static int WriteCallback(void *sctp_ptr, void *data, size_t len, uint8_t tos, uint8_t set_df);
@@ -128,6 +140,9 @@ private:
 
 	class InstancesSet;
 	static InstancesSet *Instances;
+
+	class TimerScheduler;
+	static TimerScheduler *Timers;
 };
 
 } // namespace rtc::impl
@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "sendscheduler.hpp"
+#include "internals.hpp"
+#include "threadpool.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+
+namespace rtc::impl {
+
+SendScheduler::Class SendScheduler::Classify(const byte *data, size_t size, unsigned int dscp) {
+	if (dscp == 46) // EF: Expedited Forwarding, set on audio tracks
+		return Class::Audio;
+
+	// RFC 5764: If the value [of the first byte] is in between 128 and 191 (inclusive), then the
+	// packet is RTP (or RTCP)
+	if (size > 0) {
+		uint8_t first = std::to_integer<uint8_t>(data[0]);
+		if (first >= 128 && first <= 191)
+			return Class::Video;
+	}
+
+	// DTLS records carry SCTP and handshake traffic
+	return Class::Data;
+}
+
+SendScheduler::SendScheduler(const Configuration &config, send_function sendFunc)
+    : mRate(double(config.sendRateBudget.value_or(0))),
+      mBurst(std::max(mRate * std::chrono::duration<double>(SEND_SCHEDULER_BURST).count(),
+                      double(DEFAULT_MTU))),
+      mSendFunc(std::move(sendFunc)), mTokens(mBurst), mLastRefill(clock::now()) {
+
+	if (mRate <= 0)
+		throw std::invalid_argument("Send rate budget must be positive");
+
+	mQueues[int(Class::Audio)].budget = config.audioSendQueueBudget;
+	mQueues[int(Class::Video)].budget = config.videoSendQueueBudget;
+	mQueues[int(Class::Data)].budget = config.dataSendQueueBudget;
+}
+
+SendScheduler::~SendScheduler() { stop(); }
+
+bool SendScheduler::send(const byte *data, size_t size, unsigned int dscp) {
+	return schedule(data, size, dscp, nullptr);
+}
+
+bool SendScheduler::send(message_ptr message) {
+	if (!message)
+		return false;
+
+	return schedule(message->data(), message->size(), message->dscp, message);
+}
+
+void SendScheduler::stop() {
+	std::lock_guard lock(mMutex);
+	mStopped = true;
+	mSendFunc = nullptr;
+	for (auto &queue : mQueues) {
+		queue.messages.clear();
+		queue.amount = 0;
+	}
+}
+
+SendQueueStats SendScheduler::stats() const {
+	std::lock_guard lock(mMutex);
+	auto convert = [](const Queue &queue) {
+		SendQueueStats::Queue result;
+		result.packets = queue.messages.size();
+		result.bytes = queue.amount;
+		result.peakBytes = queue.peak;
+		result.dropped = queue.dropped;
+		return result;
+	};
+
+	SendQueueStats result;
+	result.audio = convert(mQueues[int(Class::Audio)]);
+	result.video = convert(mQueues[int(Class::Video)]);
+	result.data = convert(mQueues[int(Class::Data)]);
+	return result;
+}
+
+void SendScheduler::clearStats() {
+	std::lock_guard lock(mMutex);
+	for (auto &queue : mQueues) {
+		queue.peak = queue.amount;
+		queue.dropped = 0;
+	}
+}
+
+bool SendScheduler::schedule(const byte *data, size_t size, unsigned int dscp,
+                             message_ptr message) {
+	const Class cls = Classify(data, size, dscp);
+
+	std::lock_guard lock(mMutex);
+	if (mStopped)
+		return false;
+
+	refill(clock::now());
+
+	// Strict priority: send right away only if nothing of the same or higher priority is waiting
+	if (mTokens > 0 && !hasQueued(cls)) {
+		mTokens -= double(size);
+		return mSendFunc(data, size, dscp);
+	}
+
+	auto &queue = mQueues[int(cls)];
+	if (queue.amount + size > queue.budget) {
+		++queue.dropped;
+		PLOG_VERBOSE << "Send queue budget exceeded, dropping datagram, size=" << size;
+		return false;
+	}
+
+	if (!message) {
+		// The buffer is not retained by the caller
+		message = make_message(data, data + size);
+		message->dscp = dscp;
+	}
+
+	queue.amount += size;
+	queue.peak = std::max(queue.peak, queue.amount);
+	queue.messages.push_back(std::move(message));
+	scheduleDrain();
+	return true;
+}
+
+void SendScheduler::drain() {
+	std::lock_guard lock(mMutex);
+	mDrainScheduled = false;
+	if (mStopped)
+		return;
+
+	refill(clock::now());
+
+	while (mTokens > 0) {
+		auto it = std::find_if(mQueues.begin(), mQueues.end(),
+		                       [](const Queue &queue) { return !queue.messages.empty(); });
+		if (it == mQueues.end())
+			break;
+
+		auto message = std::move(it->messages.front());
+		it->messages.pop_front();
+		it->amount -= message->size();
+		mTokens -= double(message->size());
+
+		try {
+			mSendFunc(message->data(), message->size(), message->dscp);
+		} catch (const std::exception &e) {
+			PLOG_WARNING << e.what();
+		}
+	}
+
+	if (hasQueued(Class::Data))
+		scheduleDrain();
+}
+
+void SendScheduler::scheduleDrain() {
+	if (mDrainScheduled)
+		return;
+
+	// Wait until the bucket has refilled enough for the deficit to be paid back
+	auto wait = std::chrono::duration<double>(mTokens > 0 ? 0. : (1. - mTokens) / mRate);
+	auto delay = std::max(std::chrono::duration_cast<clock::duration>(wait),
+	                      clock::duration(SEND_SCHEDULER_MIN_INTERVAL));
+
+	mDrainScheduled = true;
+	ThreadPool::Instance().schedule(delay, weak_bind(&SendScheduler::drain, this));
+}
+
+void SendScheduler::refill(clock::time_point now) {
+	double elapsed = std::chrono::duration<double>(now - mLastRefill).count();
+	mLastRefill = now;
+	mTokens = std::min(mTokens + mRate * elapsed, mBurst);
+}
+
+bool SendScheduler::hasQueued(Class cls) const {
+	for (int i = 0; i <= int(cls); ++i)
+		if (!mQueues[i].messages.empty())
+			return true;
+
+	return false;
+}
+
+} // namespace rtc::impl
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_SEND_SCHEDULER_H
+#define RTC_IMPL_SEND_SCHEDULER_H
+
+#include "common.hpp"
+#include "configuration.hpp"
+#include "message.hpp"
+
+#include "rtc/peerconnection.hpp"
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace rtc::impl {
+
+// Paces datagrams sent on the ICE path to a byte rate budget. Waiting datagrams are sent with
+// strict priority for audio, then video, then data, so a large data upload can't fill the socket
+// buffer in front of audio.
+class SendScheduler final : public std::enable_shared_from_this<SendScheduler> {
+public:
+	using clock = std::chrono::steady_clock;
+	using send_function = std::function<bool(const byte *data, size_t size, unsigned int dscp)>;
+
+	enum class Class : int { Audio = 0, Video = 1, Data = 2 };
+	static Class Classify(const byte *data, size_t size, unsigned int dscp);
+
+	SendScheduler(const Configuration &config, send_function sendFunc);
+	~SendScheduler();
+
+	// Data is copied only if it has to be queued, false if dropped
+	bool send(const byte *data, size_t size, unsigned int dscp);
+	bool send(message_ptr message);
+	void stop();
+
+	SendQueueStats stats() const;
+	void clearStats();
+
+private:
+	struct Queue {
+		std::deque<message_ptr> messages;
+		size_t amount = 0;
+		size_t budget = 0;
+		size_t peak = 0;
+		size_t dropped = 0;
+	};
+
+	bool schedule(const byte *data, size_t size, unsigned int dscp, message_ptr message);
+	void drain();
+	void scheduleDrain(); // mMutex must be held
+	void refill(clock::time_point now); // same
+	bool hasQueued(Class cls) const;     // same
+
+	const double mRate; // bytes per second
+	const double mBurst;
+	send_function mSendFunc;
+
+	std::array<Queue, 3> mQueues;
+	double mTokens;
+	clock::time_point mLastRefill;
+	bool mDrainScheduled = false;
+	bool mStopped = false;
+	// Held while sending to keep datagrams ordered, so all sends of the transport are serialized
+	mutable std::mutex mMutex;
+};
+
+} // namespace rtc::impl
+
+#endif
@@ -128,48 +128,30 @@ void TcpTransport::connect() {
 }
 
 void TcpTransport::resolve() {
-	std::lock_guard lock(mSendMutex);
-	mResolved.clear();
-
 	if (state() != State::Connecting)
 		return; // Cancelled
 
-	try {
-		PLOG_DEBUG << "Resolving " << mHostname << ":" << mService;
-
-		struct addrinfo hints = {};
-		hints.ai_family = AF_UNSPEC;
-		hints.ai_socktype = SOCK_STREAM;
-		hints.ai_protocol = IPPROTO_TCP;
-		hints.ai_flags = AI_ADDRCONFIG;
-
-		struct addrinfo *result = nullptr;
-		if (getaddrinfo(mHostname.c_str(), mService.c_str(), &hints, &result))
-			throw std::runtime_error("Resolution failed for \"" + mHostname + ":" + mService +
-			                         "\"");
-
-		try {
-			struct addrinfo *ai = result;
-			while (ai) {
-				struct sockaddr_storage addr;
-				std::memcpy(&addr, ai->ai_addr, ai->ai_addrlen);
-				mResolved.emplace_back(addr, socklen_t(ai->ai_addrlen));
-				ai = ai->ai_next;
-			}
+	// The lookup runs on the resolver threads and is served from the cache if possible
+	PLOG_DEBUG << "Resolving " << mHostname << ":" << mService;
+	Resolver::Instance().resolve(mHostname, mService, SOCK_STREAM,
+	                             weak_bind(&TcpTransport::processResolved, this, _1));
+}
 
-		} catch (...) {
-			freeaddrinfo(result);
-			throw;
-		}
+void TcpTransport::processResolved(optional<Resolver::address_list> addresses) {
+	std::lock_guard lock(mSendMutex);
+	mResolved.clear();
 
-		freeaddrinfo(result);
+	if (state() != State::Connecting)
+		return; // Cancelled
 
-	} catch (const std::exception &e) {
-		PLOG_WARNING << e.what();
+	if (!addresses) {
+		PLOG_WARNING << "Resolution failed for \"" << mHostname << ":" << mService << "\"";
 		changeState(State::Failed);
 		return;
 	}
 
+	mResolved.assign(addresses->begin(), addresses->end());
+
 	ThreadPool::Instance().enqueue(weak_bind(&TcpTransport::attempt, this));
 }
 
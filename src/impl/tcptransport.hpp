@@ -12,6 +12,7 @@
 #include "common.hpp"
 #include "pollservice.hpp"
 #include "queue.hpp"
+#include "resolver.hpp"
 #include "socket.hpp"
 #include "transport.hpp"
 
@@ -47,6 +48,7 @@ public:
 private:
 	void connect();
 	void resolve();
+	void processResolved(optional<Resolver::address_list> addresses);
 	void attempt();
 	void createSocket(const struct sockaddr *addr, socklen_t addrlen);
 	void configureSocket();
@@ -9,6 +9,7 @@
 #include "tls.hpp"
 
 #include <fstream>
+#include <mutex>
 #include <stdexcept>
 
 #if USE_GNUTLS
@@ -146,6 +147,52 @@ std::shared_ptr<mbedtls_x509_crt> new_x509_crt() {
 	                                         }};
 }
 
+namespace {
+
+struct shared_ssl_config {
+	shared_ssl_config() {
+		mbedtls_entropy_init(&entropy);
+		mbedtls_ctr_drbg_init(&drbg);
+		mbedtls_ssl_config_init(&conf);
+		mbedtls_ctr_drbg_set_prediction_resistance(&drbg, MBEDTLS_CTR_DRBG_PR_ON);
+	}
+
+	~shared_ssl_config() {
+		mbedtls_ssl_config_free(&conf);
+		mbedtls_ctr_drbg_free(&drbg);
+		mbedtls_entropy_free(&entropy);
+	}
+
+	static int random(void *ctx, unsigned char *buf, size_t len) {
+		auto c = static_cast<shared_ssl_config *>(ctx);
+		std::lock_guard lock(c->mutex);
+		return mbedtls_ctr_drbg_random(&c->drbg, buf, len);
+	}
+
+	mbedtls_entropy_context entropy;
+	mbedtls_ctr_drbg_context drbg;
+	std::mutex mutex;
+	mbedtls_ssl_config conf;
+};
+
+} // namespace
+
+std::shared_ptr<mbedtls_ssl_config> new_ssl_config(int endpoint, int transport) {
+	auto shared = std::make_shared<shared_ssl_config>();
+
+	mbedtls::check(
+	    mbedtls_ctr_drbg_seed(&shared->drbg, mbedtls_entropy_func, &shared->entropy, NULL, 0),
+	    "Failed creating Mbed TLS Context");
+
+	mbedtls::check(mbedtls_ssl_config_defaults(&shared->conf, endpoint, transport,
+	                                           MBEDTLS_SSL_PRESET_DEFAULT),
+	               "Failed creating Mbed TLS Context");
+
+	mbedtls_ssl_conf_rng(&shared->conf, shared_ssl_config::random, shared.get());
+
+	return std::shared_ptr<mbedtls_ssl_config>(shared, &shared->conf);
+}
+
 } // namespace rtc::mbedtls
 
 #else // OPENSSL
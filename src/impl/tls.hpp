@@ -59,6 +59,10 @@ string format_time(const std::chrono::system_clock::time_point &tp);
 std::shared_ptr<mbedtls_pk_context> new_pk_context();
 std::shared_ptr<mbedtls_x509_crt> new_x509_crt();
 
+// Create a configuration with defaults for endpoint and transport and its own random generator,
+// which is locked so the configuration can be shared by concurrent SSL contexts
+std::shared_ptr<mbedtls_ssl_config> new_ssl_config(int endpoint, int transport);
+
 } // namespace rtc::mbedtls
 
 #else // OPENSSL
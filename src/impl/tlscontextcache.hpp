@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_TLS_CONTEXT_CACHE_H
+#define RTC_IMPL_TLS_CONTEXT_CACHE_H
+
+#include "certificate.hpp"
+#include "common.hpp"
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace rtc::impl {
+
+// Cache of TLS contexts shared between transports, keyed by local certificate and role. An entry
+// is kept as long as its certificate is alive, transports hold a reference to the context they
+// use so it outlives the entry if necessary.
+template <typename Context> class TlsContextCache {
+public:
+	using context_ptr = shared_ptr<Context>;
+	using factory_function = std::function<context_ptr()>;
+
+	context_ptr get(const certificate_ptr &certificate, bool isClient, factory_function make);
+	void clear();
+
+private:
+	using Key = std::pair<const Certificate *, bool>;
+
+	struct Entry {
+		std::weak_ptr<Certificate> certificate;
+		context_ptr context;
+	};
+
+	void purge();
+
+	std::map<Key, Entry> mEntries;
+	std::mutex mMutex;
+};
+
+template <typename Context>
+typename TlsContextCache<Context>::context_ptr
+TlsContextCache<Context>::get(const certificate_ptr &certificate, bool isClient,
+                              factory_function make) {
+	std::lock_guard lock(mMutex);
+	Key key(certificate.get(), isClient);
+	if (auto it = mEntries.find(key); it != mEntries.end()) {
+		// The address might have been reused by another certificate
+		if (it->second.certificate.lock() == certificate)
+			return it->second.context;
+
+		mEntries.erase(it);
+	}
+
+	purge();
+
+	auto context = make();
+	mEntries.emplace(std::move(key), Entry{certificate, context});
+	return context;
+}
+
+template <typename Context> void TlsContextCache<Context>::clear() {
+	std::lock_guard lock(mMutex);
+	mEntries.clear();
+}
+
+template <typename Context> void TlsContextCache<Context>::purge() {
+	auto it = mEntries.begin();
+	while (it != mEntries.end()) {
+		if (it->first.first && it->second.certificate.expired())
+			it = mEntries.erase(it);
+		else
+			++it;
+	}
+}
+
+} // namespace rtc::impl
+
+#endif
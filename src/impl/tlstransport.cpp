@@ -305,12 +305,27 @@ int TlsTransport::TimeoutCallback(gnutls_transport_ptr_t ptr, unsigned int /* ms
 
 #elif USE_MBEDTLS
 
+TlsContextCache<mbedtls_ssl_config> TlsTransport::ConfigCache;
+
 void TlsTransport::Init() {
 	// Nothing to do
 }
 
-void TlsTransport::Cleanup() {
-	// Nothing to do
+void TlsTransport::Cleanup() { ConfigCache.clear(); }
+
+shared_ptr<mbedtls_ssl_config> TlsTransport::CreateConfig(certificate_ptr certificate,
+                                                          bool isClient) {
+	auto conf = mbedtls::new_ssl_config(isClient ? MBEDTLS_SSL_IS_CLIENT : MBEDTLS_SSL_IS_SERVER,
+	                                    MBEDTLS_SSL_TRANSPORT_STREAM);
+
+	mbedtls_ssl_conf_authmode(conf.get(), MBEDTLS_SSL_VERIFY_OPTIONAL);
+
+	if (certificate) {
+		auto [crt, pk] = certificate->credentials();
+		mbedtls::check(mbedtls_ssl_conf_own_cert(conf.get(), crt.get(), pk.get()));
+	}
+
+	return conf;
 }
 
 TlsTransport::TlsTransport(variant<shared_ptr<TcpTransport>, shared_ptr<HttpProxyTransport>> lower,
@@ -319,39 +334,19 @@ TlsTransport::TlsTransport(variant<shared_ptr<TcpTransport>, shared_ptr<HttpProx
     : Transport(std::visit([](auto l) { return std::static_pointer_cast<Transport>(l); }, lower),
                 std::move(callback)),
       mHost(std::move(host)), mIsClient(std::visit([](auto l) { return l->isActive(); }, lower)),
-      mIncomingQueue(RECV_QUEUE_LIMIT, message_size_func) {
+      mIncomingQueue(RECV_QUEUE_LIMIT, message_size_func), mCertificate(std::move(certificate)) {
 
 	PLOG_DEBUG << "Initializing TLS transport (MbedTLS)";
 
-	mbedtls_entropy_init(&mEntropy);
-	mbedtls_ctr_drbg_init(&mDrbg);
 	mbedtls_ssl_init(&mSsl);
-	mbedtls_ssl_config_init(&mConf);
-	mbedtls_ctr_drbg_set_prediction_resistance(&mDrbg, MBEDTLS_CTR_DRBG_PR_ON);
 
 	try {
-		mbedtls::check(mbedtls_ctr_drbg_seed(&mDrbg, mbedtls_entropy_func, &mEntropy, NULL, 0));
-
-		mbedtls::check(mbedtls_ssl_config_defaults(
-		    &mConf, mIsClient ? MBEDTLS_SSL_IS_CLIENT : MBEDTLS_SSL_IS_SERVER,
-		    MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT));
-
-		mbedtls_ssl_conf_authmode(&mConf, MBEDTLS_SSL_VERIFY_OPTIONAL);
-		mbedtls_ssl_conf_rng(&mConf, mbedtls_ctr_drbg_random, &mDrbg);
-
-		if (certificate) {
-			auto [crt, pk] = certificate->credentials();
-			mbedtls::check(mbedtls_ssl_conf_own_cert(&mConf, crt.get(), pk.get()));
-		}
-
-		mbedtls::check(mbedtls_ssl_setup(&mSsl, &mConf));
-		mbedtls_ssl_set_bio(&mSsl, static_cast<void *>(this), WriteCallback, ReadCallback, NULL);
+		// The configuration is shared between transports using the same certificate and role
+		setupSsl(ConfigCache.get(mCertificate, mIsClient,
+		                         [this]() { return CreateConfig(mCertificate, mIsClient); }));
 
 	} catch (...) {
-		mbedtls_entropy_free(&mEntropy);
-		mbedtls_ctr_drbg_free(&mDrbg);
 		mbedtls_ssl_free(&mSsl);
-		mbedtls_ssl_config_free(&mConf);
 		throw;
 	}
 }
@@ -360,10 +355,17 @@ TlsTransport::~TlsTransport() {
 	stop();
 
 	PLOG_DEBUG << "Destroying TLS transport";
-	mbedtls_entropy_free(&mEntropy);
-	mbedtls_ctr_drbg_free(&mDrbg);
 	mbedtls_ssl_free(&mSsl);
-	mbedtls_ssl_config_free(&mConf);
+}
+
+void TlsTransport::setupSsl(shared_ptr<mbedtls_ssl_config> conf) {
+	// The context might have been set up already, it must be reset before setting it up again
+	mbedtls_ssl_free(&mSsl);
+	mbedtls_ssl_init(&mSsl);
+	mConf = std::move(conf);
+
+	mbedtls::check(mbedtls_ssl_setup(&mSsl, mConf.get()));
+	mbedtls_ssl_set_bio(&mSsl, static_cast<void *>(this), WriteCallback, ReadCallback, NULL);
 }
 
 void TlsTransport::start() {
@@ -548,6 +550,7 @@ int TlsTransport::ReadCallback(void *ctx, unsigned char *buf, size_t len) {
 #else
 
 int TlsTransport::TransportExIndex = -1;
+TlsContextCache<SSL_CTX> TlsTransport::ContextCache;
 
 void TlsTransport::Init() {
 	openssl::init();
@@ -557,8 +560,47 @@ void TlsTransport::Init() {
 	}
 }
 
-void TlsTransport::Cleanup() {
-	// Nothing to do
+void TlsTransport::Cleanup() { ContextCache.clear(); }
+
+shared_ptr<SSL_CTX> TlsTransport::CreateContext(certificate_ptr certificate) {
+	auto ctx = shared_ptr<SSL_CTX>(SSL_CTX_new(SSLv23_method()), SSL_CTX_free); // version-flexible
+	if (!ctx)
+		throw std::runtime_error("Failed to create SSL context");
+
+	openssl::check(SSL_CTX_set_cipher_list(ctx.get(), "ALL:!LOW:!EXP:!RC4:!MD5:@STRENGTH"),
+	               "Failed to set SSL priorities");
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000
+	openssl::check(SSL_CTX_set1_groups_list(ctx.get(), "P-256"), "Failed to set SSL groups");
+#else
+	auto ecdh = unique_ptr<EC_KEY, decltype(&EC_KEY_free)>(
+	    EC_KEY_new_by_curve_name(NID_X9_62_prime256v1), EC_KEY_free);
+	SSL_CTX_set_tmp_ecdh(ctx.get(), ecdh.get());
+	SSL_CTX_set_options(ctx.get(), SSL_OP_SINGLE_ECDH_USE);
+#endif
+
+	if (certificate) {
+		auto [x509, pkey] = certificate->credentials();
+		SSL_CTX_use_certificate(ctx.get(), x509);
+		SSL_CTX_use_PrivateKey(ctx.get(), pkey);
+	} else {
+		if (!SSL_CTX_set_default_verify_paths(ctx.get())) {
+			PLOG_WARNING << "SSL root CA certificates unavailable";
+		}
+	}
+
+	SSL_CTX_set_options(ctx.get(), SSL_OP_NO_SSLv3 | SSL_OP_NO_RENEGOTIATION);
+	SSL_CTX_set_min_proto_version(ctx.get(), TLS1_VERSION);
+	SSL_CTX_set_read_ahead(ctx.get(), 1);
+	SSL_CTX_set_quiet_shutdown(ctx.get(), 0); // send the close_notify alert
+	SSL_CTX_set_info_callback(ctx.get(), InfoCallback);
+	SSL_CTX_set_verify(ctx.get(), SSL_VERIFY_NONE, NULL);
+
+	// Keep the previous behavior of a context per connection, sessions are not resumed
+	SSL_CTX_set_options(ctx.get(), SSL_OP_NO_TICKET);
+	SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_OFF);
+
+	return ctx;
 }
 
 TlsTransport::TlsTransport(variant<shared_ptr<TcpTransport>, shared_ptr<HttpProxyTransport>> lower,
@@ -572,39 +614,11 @@ TlsTransport::TlsTransport(variant<shared_ptr<TcpTransport>, shared_ptr<HttpProx
 	PLOG_DEBUG << "Initializing TLS transport (OpenSSL)";
 
 	try {
-		if (!(mCtx = SSL_CTX_new(SSLv23_method()))) // version-flexible
-			throw std::runtime_error("Failed to create SSL context");
-
-		openssl::check(SSL_CTX_set_cipher_list(mCtx, "ALL:!LOW:!EXP:!RC4:!MD5:@STRENGTH"),
-		               "Failed to set SSL priorities");
-
-#if OPENSSL_VERSION_NUMBER >= 0x30000000
-		openssl::check(SSL_CTX_set1_groups_list(mCtx, "P-256"), "Failed to set SSL groups");
-#else
-		auto ecdh = unique_ptr<EC_KEY, decltype(&EC_KEY_free)>(
-		    EC_KEY_new_by_curve_name(NID_X9_62_prime256v1), EC_KEY_free);
-		SSL_CTX_set_tmp_ecdh(mCtx, ecdh.get());
-		SSL_CTX_set_options(mCtx, SSL_OP_SINGLE_ECDH_USE);
-#endif
-
-		if (certificate) {
-			auto [x509, pkey] = certificate->credentials();
-			SSL_CTX_use_certificate(mCtx, x509);
-			SSL_CTX_use_PrivateKey(mCtx, pkey);
-		} else {
-			if (!SSL_CTX_set_default_verify_paths(mCtx)) {
-				PLOG_WARNING << "SSL root CA certificates unavailable";
-			}
-		}
-
-		SSL_CTX_set_options(mCtx, SSL_OP_NO_SSLv3 | SSL_OP_NO_RENEGOTIATION);
-		SSL_CTX_set_min_proto_version(mCtx, TLS1_VERSION);
-		SSL_CTX_set_read_ahead(mCtx, 1);
-		SSL_CTX_set_quiet_shutdown(mCtx, 0); // send the close_notify alert
-		SSL_CTX_set_info_callback(mCtx, InfoCallback);
-		SSL_CTX_set_verify(mCtx, SSL_VERIFY_NONE, NULL);
+		// The context is shared between transports using the same certificate and role
+		mCtx = ContextCache.get(certificate, mIsClient,
+		                        [&certificate]() { return CreateContext(certificate); });
 
-		if (!(mSsl = SSL_new(mCtx)))
+		if (!(mSsl = SSL_new(mCtx.get())))
 			throw std::runtime_error("Failed to create SSL instance");
 
 		SSL_set_ex_data(mSsl, TransportExIndex, this);
@@ -632,8 +646,6 @@ TlsTransport::TlsTransport(variant<shared_ptr<TcpTransport>, shared_ptr<HttpProx
 	} catch (...) {
 		if (mSsl)
 			SSL_free(mSsl);
-		if (mCtx)
-			SSL_CTX_free(mCtx);
 		throw;
 	}
 }
@@ -643,7 +655,6 @@ TlsTransport::~TlsTransport() {
 
 	PLOG_DEBUG << "Destroying TLS transport";
 	SSL_free(mSsl);
-	SSL_CTX_free(mCtx);
 }
 
 void TlsTransport::start() {
@@ -13,6 +13,7 @@
 #include "common.hpp"
 #include "queue.hpp"
 #include "tls.hpp"
+#include "tlscontextcache.hpp"
 #include "transport.hpp"
 
 #if RTC_ENABLE_WEBSOCKET
@@ -67,9 +68,8 @@ protected:
 	static int TimeoutCallback(gnutls_transport_ptr_t ptr, unsigned int ms);
 
 #elif USE_MBEDTLS
-	mbedtls_entropy_context mEntropy;
-	mbedtls_ctr_drbg_context mDrbg;
-	mbedtls_ssl_config mConf;
+	const certificate_ptr mCertificate;
+	shared_ptr<mbedtls_ssl_config> mConf;
 	mbedtls_ssl_context mSsl;
 
 	std::mutex mSslMutex;
@@ -78,18 +78,26 @@ protected:
 	message_ptr mIncomingMessage;
 	size_t mIncomingMessagePosition = 0;
 
+	void setupSsl(shared_ptr<mbedtls_ssl_config> conf);
+
+	static TlsContextCache<mbedtls_ssl_config> ConfigCache;
+
+	static shared_ptr<mbedtls_ssl_config> CreateConfig(certificate_ptr certificate, bool isClient);
 	static int WriteCallback(void *ctx, const unsigned char *buf, size_t len);
 	static int ReadCallback(void *ctx, unsigned char *buf, size_t len);
 
 #else
-	SSL_CTX *mCtx;
-	SSL *mSsl;
+	shared_ptr<SSL_CTX> mCtx;
+	SSL *mSsl = NULL;
 	BIO *mInBio, *mOutBio;
 	std::mutex mSslMutex;
 
 	bool flushOutput();
 
 	static int TransportExIndex;
+	static TlsContextCache<SSL_CTX> ContextCache;
+
+	static shared_ptr<SSL_CTX> CreateContext(certificate_ptr certificate);
 
 	static void InfoCallback(const SSL *ssl, int where, int ret);
 #endif
@@ -73,6 +73,7 @@ void Track::close() {
 optional<message_variant> Track::receive() {
 	if (auto next = mRecvQueue.pop()) {
 		message_ptr message = *next;
+		lastArrivalTime = message->arrivalTime.value_or(std::chrono::steady_clock::time_point());
 		if (message->type == Message::Control)
 			return to_variant(**next); // The same message may be frowarded into multiple Tracks
 		else
@@ -154,6 +155,27 @@ void Track::incoming(message_ptr message) {
 	triggerAvailable(mRecvQueue.size());
 }
 
+void Track::enqueueIncoming(message_ptr message) {
+	if (!message || mIsClosed)
+		return;
+
+	// Tail drop if the backlog is full, like the receive queue
+	size_t size = message->size();
+	if (mIncomingBacklog + size > RECV_QUEUE_LIMIT) {
+		COUNTER_QUEUE_FULL++;
+		return;
+	}
+
+	mIncomingBacklog += size;
+	mIncomingProcessor.enqueue(&Track::processIncoming, shared_from_this(), std::move(message),
+	                           size);
+}
+
+void Track::processIncoming(message_ptr message, size_t size) {
+	mIncomingBacklog -= size;
+	incoming(std::move(message));
+}
+
 bool Track::outgoing(message_ptr message) {
 	if (mIsClosed)
 		throw std::runtime_error("Track is closed");
@@ -189,12 +211,7 @@ bool Track::transportSend([[maybe_unused]] message_ptr message) {
 		if (!transport)
 			throw std::runtime_error("Track is closed");
 
-		// Set recommended medium-priority DSCP value
-		// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
-		if (mMediaDescription.type() == "audio")
-			message->dscp = 46; // EF: Expedited Forwarding
-		else
-			message->dscp = 36; // AF42: Assured Forwarding class 4, medium drop probability
+		message->dscp = outgoingDscp();
 	}
 
 	return transport->sendMedia(message);
@@ -203,18 +220,54 @@ bool Track::transportSend([[maybe_unused]] message_ptr message) {
 #endif
 }
 
+bool Track::transportSendBatch([[maybe_unused]] message_vector messages) {
+#if RTC_ENABLE_MEDIA
+	shared_ptr<DtlsSrtpTransport> transport;
+	unsigned int dscp;
+	{
+		std::shared_lock lock(mMutex);
+		transport = mDtlsSrtpTransport.lock();
+		if (!transport)
+			throw std::runtime_error("Track is closed");
+
+		dscp = outgoingDscp();
+	}
+
+	for (auto &message : messages)
+		message->dscp = dscp;
+
+	return transport->sendMedia(messages) == messages.size();
+#else
+	throw std::runtime_error("Track is disabled (not compiled with media support)");
+#endif
+}
+
+unsigned int Track::outgoingDscp() const {
+	// Set recommended medium-priority DSCP value
+	// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
+	if (mMediaDescription.type() == "audio")
+		return 46; // EF: Expedited Forwarding
+	else
+		return 36; // AF42: Assured Forwarding class 4, medium drop probability
+}
+
 void Track::setMediaHandler(shared_ptr<MediaHandler> handler) {
 	auto currentHandler = getMediaHandler();
-	if (currentHandler)
+	if (currentHandler) {
 		currentHandler->onOutgoing(nullptr);
+		currentHandler->onOutgoingBatch(nullptr);
+	}
 
 	{
 		std::unique_lock lock(mMutex);
 		mMediaHandler = handler;
 	}
 
-	if (handler)
+	if (handler) {
 		handler->onOutgoing(std::bind(&Track::transportSend, this, std::placeholders::_1));
+		handler->onOutgoingBatch(
+		    std::bind(&Track::transportSendBatch, this, std::placeholders::_1));
+	}
 }
 
 shared_ptr<MediaHandler> Track::getMediaHandler() {
@@ -13,6 +13,7 @@
 #include "common.hpp"
 #include "description.hpp"
 #include "mediahandler.hpp"
+#include "processor.hpp"
 #include "queue.hpp"
 
 #if RTC_ENABLE_MEDIA
@@ -33,6 +34,7 @@ public:
 
 	void close();
 	void incoming(message_ptr message);
+	void enqueueIncoming(message_ptr message); // process incoming message on the track processor
 	bool outgoing(message_ptr message);
 
 	optional<message_variant> receive() override;
@@ -56,7 +58,10 @@ public:
 #endif
 
 private:
+	void processIncoming(message_ptr message, size_t size);
 	bool transportSend(message_ptr message);
+	bool transportSendBatch(message_vector messages);
+	unsigned int outgoingDscp() const; // must be called under mMutex
 
 	const weak_ptr<PeerConnection> mPeerConnection;
 #if RTC_ENABLE_MEDIA
@@ -71,6 +76,10 @@ private:
 	std::atomic<bool> mIsClosed = false;
 
 	Queue<message_ptr> mRecvQueue;
+
+	// Incoming messages are processed in order, but concurrently with other tracks
+	Processor mIncomingProcessor;
+	std::atomic<size_t> mIncomingBacklog = 0; // bytes waiting for the processor
 };
 
 } // namespace rtc::impl
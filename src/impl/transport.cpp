@@ -16,26 +16,38 @@ Transport::Transport(shared_ptr<Transport> lower, state_callback callback)
 Transport::~Transport() {
 	unregisterIncoming();
 
-	if (mLower) {
-		mLower->stop();
-		mLower.reset();
+	if (auto lower = std::atomic_exchange(&mLower, shared_ptr<Transport>())) {
+		lower->stop();
 	}
 }
 
 void Transport::registerIncoming() {
-	if (mLower) {
+	if (auto lower = std::atomic_load(&mLower)) {
 		PLOG_VERBOSE << "Registering incoming callback";
-		mLower->onRecv(std::bind(&Transport::incoming, this, std::placeholders::_1));
+		lower->onRecv(std::bind(&Transport::incoming, this, std::placeholders::_1));
 	}
 }
 
 void Transport::unregisterIncoming() {
-	if (mLower) {
+	if (auto lower = std::atomic_load(&mLower)) {
 		PLOG_VERBOSE << "Unregistering incoming callback";
-		mLower->onRecv(nullptr);
+		lower->onRecv(nullptr);
 	}
 }
 
+shared_ptr<Transport> Transport::replaceLower(shared_ptr<Transport> lower) {
+	if (std::atomic_load(&mLower) == lower)
+		return nullptr;
+
+	PLOG_VERBOSE << "Replacing lower transport";
+	lower->onRecv(std::bind(&Transport::incoming, this, std::placeholders::_1));
+	auto previous = std::atomic_exchange(&mLower, std::move(lower));
+	if (previous)
+		previous->onRecv(nullptr);
+
+	return previous;
+}
+
 Transport::State Transport::state() const { return mState; }
 
 void Transport::onRecv(message_callback callback) { mRecvCallback = std::move(callback); }
@@ -50,6 +62,21 @@ void Transport::stop() { unregisterIncoming(); }
 
 bool Transport::send(message_ptr message) { return outgoing(message); }
 
+bool Transport::sendBuffer(const byte *data, size_t size, unsigned int dscp) {
+	auto message = make_message(data, data + size);
+	message->dscp = dscp;
+	return send(std::move(message));
+}
+
+size_t Transport::sendBatch(const message_vector &messages) {
+	size_t count = 0;
+	for (const auto &message : messages)
+		if (message && send(message))
+			++count;
+
+	return count;
+}
+
 void Transport::recv(message_ptr message) {
 	try {
 		mRecvCallback(message);
@@ -70,10 +97,24 @@ void Transport::changeState(State state) {
 void Transport::incoming(message_ptr message) { recv(message); }
 
 bool Transport::outgoing(message_ptr message) {
-	if (mLower)
-		return mLower->send(message);
+	if (auto lower = std::atomic_load(&mLower))
+		return lower->send(message);
+	else
+		return false;
+}
+
+bool Transport::outgoingBuffer(const byte *data, size_t size, unsigned int dscp) {
+	if (auto lower = std::atomic_load(&mLower))
+		return lower->sendBuffer(data, size, dscp);
 	else
 		return false;
 }
 
+size_t Transport::outgoingBatch(const message_vector &messages) {
+	if (auto lower = std::atomic_load(&mLower))
+		return lower->sendBatch(messages);
+	else
+		return 0;
+}
+
 } // namespace rtc::impl
@@ -32,6 +32,10 @@ public:
 	void unregisterIncoming();
 	State state() const;
 
+	// Swap the lower transport, for instance on ICE restart, and return the previous one if it
+	// changed. Incoming data from the new lower transport is received from now on.
+	shared_ptr<Transport> replaceLower(shared_ptr<Transport> lower);
+
 	void onRecv(message_callback callback);
 	void onStateChange(state_callback callback);
 
@@ -39,16 +43,25 @@ public:
 	virtual void stop();
 	virtual bool send(message_ptr message);
 
+	// Send data which is not retained after the call, so it does not need to be copied into a
+	// message if the transport processes it synchronously
+	virtual bool sendBuffer(const byte *data, size_t size, unsigned int dscp);
+
+	// Send multiple messages at once, returns the number of messages sent
+	virtual size_t sendBatch(const message_vector &messages);
+
 protected:
 	void recv(message_ptr message);
 	void changeState(State state);
 	virtual void incoming(message_ptr message);
 	virtual bool outgoing(message_ptr message);
+	bool outgoingBuffer(const byte *data, size_t size, unsigned int dscp);
+	size_t outgoingBatch(const message_vector &messages);
 
 private:
 	const init_token mInitToken = Init::Instance().token();
 
-	shared_ptr<Transport> mLower;
+	shared_ptr<Transport> mLower; // accessed atomically
 	synchronized_callback<State> mStateChangeCallback;
 	synchronized_callback<message_ptr> mRecvCallback;
 
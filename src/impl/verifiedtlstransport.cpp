@@ -25,9 +25,11 @@ VerifiedTlsTransport::VerifiedTlsTransport(
 #if USE_GNUTLS
 	gnutls_session_set_verify_cert(mSession, mHost->c_str(), 0);
 #elif USE_MBEDTLS
-	mbedtls_ssl_conf_authmode(&mConf, MBEDTLS_SSL_VERIFY_REQUIRED);
 	mbedtls_x509_crt_init(&mCaCert);
 	try {
+		// The shared configuration must not be modified, so use a dedicated one
+		auto conf = CreateConfig(mCertificate, mIsClient);
+		mbedtls_ssl_conf_authmode(conf.get(), MBEDTLS_SSL_VERIFY_REQUIRED);
 		if (cacert) {
 			if (cacert->find(PemBeginCertificateTag) == string::npos) {
 				// *cacert is a file path
@@ -38,8 +40,9 @@ VerifiedTlsTransport::VerifiedTlsTransport(
 				    &mCaCert, reinterpret_cast<const unsigned char *>(cacert->c_str()),
 				    cacert->size()));
 			}
-			mbedtls_ssl_conf_ca_chain(&mConf, &mCaCert, NULL);
+			mbedtls_ssl_conf_ca_chain(conf.get(), &mCaCert, NULL);
 		}
+		setupSsl(std::move(conf));
 	} catch (...) {
 		mbedtls_x509_crt_free(&mCaCert);
 		throw;
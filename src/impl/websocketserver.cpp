@@ -18,8 +18,6 @@ namespace rtc::impl {
 
 using namespace std::placeholders;
 
-const string PemBeginCertificateTag = "-----BEGIN CERTIFICATE-----";
-
 WebSocketServer::WebSocketServer(Configuration config_)
     : config(std::move(config_)), mStopped(false) {
 	PLOG_VERBOSE << "Creating WebSocketServer";
@@ -27,11 +25,8 @@ WebSocketServer::WebSocketServer(Configuration config_)
 	// Create certificate
 	if (config.enableTls) {
 		if (config.certificatePemFile && config.keyPemFile) {
-			mCertificate = std::make_shared<Certificate>(
-			    config.certificatePemFile->find(PemBeginCertificateTag) != string::npos
-			        ? Certificate::FromString(*config.certificatePemFile, *config.keyPemFile)
-			        : Certificate::FromFile(*config.certificatePemFile, *config.keyPemFile,
-			                                config.keyPemPass.value_or("")));
+			mCertificate = CertificateProvider::Instance().load(
+			    *config.certificatePemFile, *config.keyPemFile, config.keyPemPass.value_or(""));
 
 		} else if (!config.certificatePemFile && !config.keyPemFile) {
 			mCertificate = std::make_shared<Certificate>(
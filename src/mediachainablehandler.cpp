@@ -53,11 +53,18 @@ message_ptr MediaChainableHandler::handleIncomingBinary(message_ptr msg) {
 	auto messages = root->split(msg);
 	auto incoming = getLeaf()->formIncomingBinaryMessage(
 	    messages, [this](ChainedOutgoingProduct outgoing) { return sendProduct(outgoing); });
-	if (incoming) {
-		return root->reduce(incoming);
-	} else {
+	if (!incoming)
 		return nullptr;
-	}
+
+	// A message passed through unchanged is returned as is, with its metadata
+	if (incoming->size() == 1 && incoming->front() == msg)
+		return msg;
+
+	auto reduced = root->reduce(incoming);
+	if (reduced)
+		reduced->arrivalTime = msg->arrivalTime;
+
+	return reduced;
 }
 
 message_ptr MediaChainableHandler::handleIncomingControl(message_ptr msg) {
@@ -87,13 +94,22 @@ message_ptr MediaChainableHandler::handleOutgoingBinary(message_ptr msg) {
 		LOG_DEBUG << "Invalid message to send";
 		return nullptr;
 	}
+	message_vector batch;
+	batch.reserve(outgoing.messages->size() - 1);
 	for (unsigned i = 0; i < outgoing.messages->size() - 1; i++) {
 		auto message = outgoing.messages->at(i);
 		if (!message) {
 			LOG_DEBUG << "Invalid message to send " << i + 1 << "/" << outgoing.messages->size();
+			continue;
 		}
-		if (!send(make_message(*message))) {
-			LOG_DEBUG << "Failed to send message " << i + 1 << "/" << outgoing.messages->size();
+		batch.push_back(make_message(*message));
+	}
+	// Send the packets of a frame as a burst if possible
+	if (!batch.empty() && !sendBatch(batch)) {
+		for (unsigned i = 0; i < batch.size(); i++) {
+			if (!send(batch[i])) {
+				LOG_DEBUG << "Failed to send message " << i + 1 << "/" << batch.size();
+			}
 		}
 	}
 	return make_message(*lastMessage);
@@ -137,6 +153,15 @@ message_ptr MediaChainableHandler::incoming(message_ptr ptr) {
 	return ptr;
 }
 
+bool MediaChainableHandler::sendBatch(message_vector msgs) {
+	try {
+		return outgoingBatchCallback(std::move(msgs));
+	} catch (const std::exception &e) {
+		LOG_DEBUG << "Batch send in RTCP chain handler failed: " << e.what();
+	}
+	return true; // do not retry
+}
+
 bool MediaChainableHandler::send(message_ptr msg) {
 	try {
 		outgoingCallback(std::move(msg));
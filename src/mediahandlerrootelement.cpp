@@ -14,9 +14,13 @@ namespace rtc {
 
 message_ptr MediaHandlerRootElement::reduce(ChainedMessagesProduct messages) {
 	if (messages && !messages->empty()) {
-		auto msg_ptr = messages->front();
+		auto &msg_ptr = messages->front();
 		if (msg_ptr) {
-			return make_message(*msg_ptr);
+			// Move the content out instead of copying it if nothing else references it
+			if (msg_ptr.use_count() == 1)
+				return make_message(std::move(*msg_ptr));
+			else
+				return make_message(*msg_ptr);
 		} else {
 			return nullptr;
 		}
@@ -37,6 +37,9 @@ PeerConnection::PeerConnection() : PeerConnection(Configuration()) {}
 PeerConnection::PeerConnection(Configuration config)
     : CheshireCat<impl::PeerConnection>(std::move(config)) {}
 
+PeerConnection::PeerConnection(impl_ptr<impl::PeerConnection> impl)
+    : CheshireCat<impl::PeerConnection>(std::move(impl)) {}
+
 PeerConnection::~PeerConnection() {
 	try {
 		impl()->remoteClose();
@@ -223,7 +226,9 @@ void PeerConnection::setRemoteDescription(Description description) {
 	auto remoteCandidates = description.extractCandidates();
 	auto type = description.type();
 
-	auto iceTransport = impl()->initIceTransport();
+	auto iceTransport = type == Description::Type::Offer && impl()->isIceRestart(description)
+	                        ? impl()->restartIceTransport()
+	                        : impl()->initIceTransport();
 	if (!iceTransport)
 		return; // closed
 
@@ -249,6 +254,23 @@ void PeerConnection::addRemoteCandidate(Candidate candidate) {
 	impl()->processRemoteCandidate(std::move(candidate));
 }
 
+void PeerConnection::restartIce() {
+	std::unique_lock signalingLock(impl()->signalingMutex);
+	PLOG_VERBOSE << "Restarting ICE";
+
+	if (impl()->signalingState != SignalingState::Stable)
+		throw std::logic_error("ICE restart is only possible in stable signaling state");
+
+	if (!impl()->restartIceTransport())
+		return; // closed
+
+	impl()->negotiationNeeded = true;
+	signalingLock.unlock();
+
+	if (!impl()->config.disableAutoNegotiation)
+		setLocalDescription(Description::Type::Offer);
+}
+
 void PeerConnection::setMediaHandler(shared_ptr<MediaHandler> handler) {
 	impl()->setMediaHandler(std::move(handler));
 };
@@ -335,6 +357,9 @@ bool PeerConnection::getSelectedCandidatePair(Candidate *local, Candidate *remot
 }
 
 void PeerConnection::clearStats() {
+	if (auto iceTransport = impl()->getIceTransport())
+		iceTransport->clearStats();
+
 	if (auto sctpTransport = impl()->getSctpTransport())
 		return sctpTransport->clearStats();
 }
@@ -349,11 +374,21 @@ size_t PeerConnection::bytesReceived() {
 	return sctpTransport ? sctpTransport->bytesReceived() : 0;
 }
 
+size_t PeerConnection::messagesSuperseded() {
+	auto sctpTransport = impl()->getSctpTransport();
+	return sctpTransport ? sctpTransport->messagesSuperseded() : 0;
+}
+
 optional<std::chrono::milliseconds> PeerConnection::rtt() {
 	auto sctpTransport = impl()->getSctpTransport();
 	return sctpTransport ? sctpTransport->rtt() : nullopt;
 }
 
+SendQueueStats PeerConnection::sendQueueStats() {
+	auto iceTransport = impl()->getIceTransport();
+	return iceTransport ? iceTransport->sendQueueStats() : SendQueueStats{};
+}
+
 } // namespace rtc
 
 std::ostream &operator<<(std::ostream &out, rtc::PeerConnection::State state) {
@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "peerconnectionpool.hpp"
+#include "common.hpp"
+
+#include "impl/internals.hpp"
+#include "impl/peerconnectionpool.hpp"
+
+namespace rtc {
+
+using std::chrono::microseconds;
+
+PeerConnectionPool::PeerConnectionPool(Configuration config, size_t size)
+    : CheshireCat<impl::PeerConnectionPool>(std::move(config), size) {
+	impl()->start();
+}
+
+PeerConnectionPool::~PeerConnectionPool() { impl()->close(); }
+
+void PeerConnectionPool::close() { impl()->close(); }
+
+shared_ptr<PeerConnection> PeerConnectionPool::acquire() {
+	return std::make_shared<PeerConnection>(impl()->acquire());
+}
+
+size_t PeerConnectionPool::available() const { return impl()->available(); }
+
+PeerConnectionPool::Stats PeerConnectionPool::stats() const {
+	Stats stats;
+	stats.hits = impl()->hits;
+	stats.misses = impl()->misses;
+	if (size_t count = stats.hits + stats.misses; count > 0)
+		stats.averageAcquireTime = microseconds(impl()->totalAcquireTime / int64_t(count));
+
+	stats.maxAcquireTime = microseconds(impl()->maxAcquireTime);
+	return stats;
+}
+
+void PeerConnectionPool::clearStats() { impl()->clearStats(); }
+
+} // namespace rtc
@@ -630,6 +630,100 @@ bool RtcpNack::addMissingPacket(unsigned int *fciCount, uint16_t *fciPID, uint16
 	}
 }
 
+bool RtcpCcfbMetric::received() const { return (ntohs(_value) >> 15) & 0x1; }
+
+uint8_t RtcpCcfbMetric::ecn() const { return uint8_t((ntohs(_value) >> 13) & 0x3); }
+
+uint16_t RtcpCcfbMetric::arrivalTimeOffset() const { return ntohs(_value) & 0x1FFF; }
+
+void RtcpCcfbMetric::set(bool received, uint8_t ecn, uint16_t arrivalTimeOffset) {
+	// RFC 8888: If the packet was not received, the ECN and ATO fields MUST be set to zero
+	uint16_t value = 0;
+	if (received)
+		value = uint16_t(0x8000 | ((ecn & 0x3) << 13) | (arrivalTimeOffset & 0x1FFF));
+
+	_value = htons(value);
+}
+
+size_t RtcpCcfbBlock::Size(unsigned int count) {
+	// Metric blocks are padded to a multiple of 32 bits
+	return offsetof(RtcpCcfbBlock, metrics) + ((count * sizeof(RtcpCcfbMetric) + 3) & ~size_t(3));
+}
+
+SSRC RtcpCcfbBlock::ssrc() const { return ntohl(_ssrc); }
+
+uint16_t RtcpCcfbBlock::beginSeq() const { return ntohs(_beginSeq); }
+
+unsigned int RtcpCcfbBlock::metricsCount() const { return ntohs(_numReports); }
+
+size_t RtcpCcfbBlock::getSize() const { return Size(metricsCount()); }
+
+void RtcpCcfbBlock::prepareBlock(SSRC ssrc, uint16_t beginSeq, unsigned int count) {
+	_ssrc = htonl(ssrc);
+	_beginSeq = htons(beginSeq);
+	_numReports = htons(uint16_t(count));
+	std::memset(metrics, 0, Size(count) - offsetof(RtcpCcfbBlock, metrics));
+}
+
+size_t RtcpCcfb::Size(size_t blocksSize) {
+	return sizeof(RtcpCcfb) + blocksSize + sizeof(uint32_t);
+}
+
+SSRC RtcpCcfb::senderSSRC() const { return ntohl(_senderSSRC); }
+
+uint32_t RtcpCcfb::reportTimestamp() const {
+	uint32_t timestamp;
+	std::memcpy(&timestamp,
+	            reinterpret_cast<const char *>(this) + header.lengthInBytes() - sizeof(uint32_t),
+	            sizeof(uint32_t));
+	return ntohl(timestamp);
+}
+
+std::vector<const RtcpCcfbBlock *> RtcpCcfb::blocks() const {
+	std::vector<const RtcpCcfbBlock *> result;
+	const char *begin = reinterpret_cast<const char *>(this);
+	const size_t end = header.lengthInBytes() - sizeof(uint32_t);
+	size_t offset = sizeof(RtcpCcfb);
+	while (offset + offsetof(RtcpCcfbBlock, metrics) <= end) {
+		auto block = reinterpret_cast<const RtcpCcfbBlock *>(begin + offset);
+		size_t size = block->getSize();
+		if (offset + size > end)
+			break;
+
+		result.push_back(block);
+		offset += size;
+	}
+	return result;
+}
+
+unsigned int RtcpCcfb::congestionExperiencedCount() const {
+	const uint8_t ce = 0x3; // Congestion Experienced codepoint (RFC 3168)
+	unsigned int count = 0;
+	for (const auto *block : blocks())
+		for (unsigned int i = 0; i < block->metricsCount(); ++i)
+			if (block->metrics[i].received() && block->metrics[i].ecn() == ce)
+				++count;
+
+	return count;
+}
+
+RtcpCcfbBlock *RtcpCcfb::getBlock(size_t offset) {
+	return reinterpret_cast<RtcpCcfbBlock *>(reinterpret_cast<char *>(this) + sizeof(RtcpCcfb) +
+	                                         offset);
+}
+
+void RtcpCcfb::preparePacket(SSRC senderSSRC, size_t blocksSize) {
+	// RFC 8888: The RTCP Congestion Control Feedback message is an RTPFB message with FMT=11
+	header.prepareHeader(205, 11, uint16_t(Size(blocksSize) / 4 - 1));
+	_senderSSRC = htonl(senderSSRC);
+}
+
+void RtcpCcfb::setReportTimestamp(uint32_t timestamp) {
+	timestamp = htonl(timestamp);
+	std::memcpy(reinterpret_cast<char *>(this) + header.lengthInBytes() - sizeof(uint32_t),
+	            &timestamp, sizeof(uint32_t));
+}
+
 uint16_t RtpRtx::getOriginalSeqNo() const { return ntohs(*(uint16_t *)(header.getBody())); }
 
 const char *RtpRtx::getBody() const { return header.getBody() + sizeof(uint16_t); }
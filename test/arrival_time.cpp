@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtc/rtc.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#endif
+
+using namespace rtc;
+using namespace std;
+using clock_type = std::chrono::steady_clock;
+
+// Arrival times are taken at reception by the ICE transport, so they must fall between the send
+// and the delivery to the application
+static bool checkArrivalTime(const Channel &channel, clock_type::time_point sendTime) {
+	auto arrivalTime = channel.lastArrivalTime();
+	return arrivalTime && *arrivalTime >= sendTime && *arrivalTime <= clock_type::now();
+}
+
+void test_arrival_time() {
+	InitLogger(LogLevel::Debug);
+
+	PeerConnection pc1;
+	PeerConnection pc2;
+
+	pc1.onLocalDescription([&pc2](Description sdp) { pc2.setRemoteDescription(string(sdp)); });
+	pc1.onLocalCandidate(
+	    [&pc2](Candidate candidate) { pc2.addRemoteCandidate(string(candidate)); });
+
+	pc2.onLocalDescription([&pc1](Description sdp) { pc1.setRemoteDescription(string(sdp)); });
+	pc2.onLocalCandidate(
+	    [&pc1](Candidate candidate) { pc1.addRemoteCandidate(string(candidate)); });
+
+	shared_ptr<DataChannel> dc2;
+	pc2.onDataChannel([&dc2](shared_ptr<DataChannel> dc) { std::atomic_store(&dc2, dc); });
+
+#if RTC_ENABLE_MEDIA
+	const uint32_t ssrc = 1234;
+	shared_ptr<Track> t2;
+	pc2.onTrack([&t2](shared_ptr<Track> t) { std::atomic_store(&t2, t); });
+
+	Description::Video media("video", Description::Direction::SendOnly);
+	media.addH264Codec(96);
+	media.addSSRC(ssrc, "video-send");
+	auto t1 = pc1.addTrack(media);
+#endif
+
+	auto dc1 = pc1.createDataChannel("test");
+
+	int attempts = 10;
+	while ((!std::atomic_load(&dc2) || !dc1->isOpen()) && attempts--)
+		this_thread::sleep_for(1s);
+
+	auto adc2 = std::atomic_load(&dc2);
+	if (!adc2 || !dc1->isOpen())
+		throw runtime_error("DataChannel is not open");
+
+	// A small message fits in a single SCTP packet, a large one is reassembled from many packets
+	const size_t largeSize = 128 * 1024;
+	auto sendTime = clock_type::now();
+	std::atomic<int> received = 0;
+	std::atomic<int> stamped = 0;
+	adc2->onMessage([&, dc = adc2.get()](message_variant message) {
+		if (checkArrivalTime(*dc, sendTime))
+			++stamped;
+		else
+			cerr << "Wrong arrival time on DataChannel message" << endl;
+
+		if (auto data = get_if<binary>(&message); data && data->size() == largeSize)
+			cout << "Reassembled message received" << endl;
+
+		++received;
+	});
+
+	dc1->send("Hello from 1");
+	dc1->send(binary(largeSize, byte(0)));
+
+	attempts = 10;
+	while (received < 2 && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (received != 2)
+		throw runtime_error("DataChannel messages were not received");
+
+	if (stamped != received)
+		throw runtime_error("DataChannel messages are not stamped with their arrival time");
+
+#if RTC_ENABLE_MEDIA
+	shared_ptr<Track> at2;
+	attempts = 10;
+	while ((!(at2 = std::atomic_load(&t2)) || !at2->isOpen() || !t1->isOpen()) && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (!at2 || !at2->isOpen() || !t1->isOpen())
+		throw runtime_error("Track is not open");
+
+	std::atomic<bool> trackReceived = false;
+	std::atomic<bool> trackStamped = false;
+	sendTime = clock_type::now();
+	at2->onMessage([&, t = at2.get()](message_variant message) {
+		if (!holds_alternative<binary>(message))
+			return;
+
+		trackStamped = checkArrivalTime(*t, sendTime);
+		trackReceived = true;
+	});
+
+	// Minimal RTP packet for the SSRC of the track
+	binary packet(12 + 100, byte(0));
+	packet[0] = byte(0x80); // version 2
+	packet[1] = byte(96);   // payload type
+	uint32_t ssrcBe = htonl(ssrc);
+	std::memcpy(packet.data() + 8, &ssrcBe, sizeof(ssrcBe));
+
+	attempts = 10;
+	while (!trackReceived && attempts--) {
+		t1->send(packet);
+		this_thread::sleep_for(1s);
+	}
+
+	if (!trackReceived)
+		throw runtime_error("Track message was not received");
+
+	if (!trackStamped)
+		throw runtime_error("Track message is not stamped with its arrival time");
+#endif
+
+	pc1.close();
+	pc2.close();
+	this_thread::sleep_for(1s);
+
+	cout << "Success" << endl;
+}
@@ -10,9 +10,14 @@
 
 #include <atomic>
 #include <chrono>
+#include <ctime>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace rtc;
 using namespace std;
@@ -161,6 +166,355 @@ size_t benchmark(milliseconds duration) {
 	return goodput;
 }
 
+#if RTC_ENABLE_WEBSOCKET
+// Open secure WebSocket connections one after the other, the rate is bound by TLS setup
+size_t benchmark_tls_setup(milliseconds duration) {
+	rtc::InitLogger(LogLevel::Warning);
+	rtc::Preload();
+
+	WebSocketServer::Configuration serverConfig;
+	serverConfig.port = 48081;
+	serverConfig.enableTls = true;
+	serverConfig.bindAddress = "127.0.0.1";
+	WebSocketServer server(std::move(serverConfig));
+
+	std::mutex mutex;
+	vector<shared_ptr<WebSocket>> clients;
+	server.onClient([&mutex, &clients](shared_ptr<WebSocket> incoming) {
+		std::lock_guard lock(mutex);
+		clients.push_back(std::move(incoming));
+	});
+
+	WebSocket::Configuration config;
+	config.disableTlsVerification = true;
+
+	size_t count = 0;
+	auto startTime = steady_clock::now();
+	while (steady_clock::now() - startTime < duration) {
+		promise<void> opened;
+		auto future = opened.get_future();
+
+		WebSocket ws(config);
+		ws.onOpen([&opened]() { opened.set_value(); });
+		ws.open("wss://127.0.0.1:48081/");
+
+		if (future.wait_for(10s) != future_status::ready)
+			throw runtime_error("WebSocket connection timed out");
+
+		++count;
+		ws.close();
+
+		std::lock_guard lock(mutex);
+		clients.clear();
+	}
+
+	auto elapsed = duration_cast<milliseconds>(steady_clock::now() - startTime);
+	size_t rate = elapsed.count() > 0 ? count * 1000 / elapsed.count() : 0;
+	cout << "TLS connections: " << count << " in " << elapsed.count() << " ms" << endl;
+	cout << "TLS setup rate: " << rate << " connections/s" << endl;
+
+	server.stop();
+
+	rtc::Cleanup();
+	return rate;
+}
+#endif
+
+// Connect PeerConnection pairs where all answerers share a single ICE UDP mux port, the number of
+// pairs is multiplied by 10 at each step. Each offerer still opens its own socket, so steps over
+// a few hundred pairs need a raised file descriptor limit.
+size_t benchmark_ice_mux(size_t maxPairs) {
+	rtc::InitLogger(LogLevel::Warning);
+	rtc::Preload();
+
+	Configuration muxConfig;
+	muxConfig.enableIceUdpMux = true;
+	muxConfig.portRangeBegin = 48082;
+	muxConfig.portRangeEnd = 48082;
+
+	size_t reached = 0;
+	for (size_t count = 10; count <= maxPairs; count *= 10) {
+		vector<shared_ptr<PeerConnection>> peers;
+		vector<shared_ptr<DataChannel>> senders;
+		std::mutex mutex;
+		vector<shared_ptr<DataChannel>> receivers;
+		atomic<size_t> openCount = 0;
+		atomic<size_t> receivedCount = 0;
+
+		try {
+			auto startTime = steady_clock::now();
+			for (size_t i = 0; i < count; ++i) {
+				auto pc1 = make_shared<PeerConnection>();
+				auto pc2 = make_shared<PeerConnection>(muxConfig);
+
+				pc1->onLocalDescription([wpc2 = make_weak_ptr(pc2)](Description sdp) {
+					if (auto pc2 = wpc2.lock())
+						pc2->setRemoteDescription(std::move(sdp));
+				});
+				pc1->onLocalCandidate([wpc2 = make_weak_ptr(pc2)](Candidate candidate) {
+					if (auto pc2 = wpc2.lock())
+						pc2->addRemoteCandidate(std::move(candidate));
+				});
+				pc2->onLocalDescription([wpc1 = make_weak_ptr(pc1)](Description sdp) {
+					if (auto pc1 = wpc1.lock())
+						pc1->setRemoteDescription(std::move(sdp));
+				});
+				pc2->onLocalCandidate([wpc1 = make_weak_ptr(pc1)](Candidate candidate) {
+					if (auto pc1 = wpc1.lock())
+						pc1->addRemoteCandidate(std::move(candidate));
+				});
+
+				pc2->onDataChannel(
+				    [&mutex, &receivers, &receivedCount](shared_ptr<DataChannel> dc) {
+					    dc->onMessage(
+					        [&receivedCount](variant<binary, string>) { ++receivedCount; });
+					    std::lock_guard lock(mutex);
+					    receivers.push_back(std::move(dc));
+				    });
+
+				auto dc = pc1->createDataChannel("mux");
+				dc->onOpen([&openCount]() { ++openCount; });
+				senders.push_back(std::move(dc));
+
+				peers.push_back(std::move(pc1));
+				peers.push_back(std::move(pc2));
+			}
+
+			auto deadline = steady_clock::now() + 60s;
+			while (openCount < count && steady_clock::now() < deadline)
+				this_thread::sleep_for(10ms);
+
+			auto connectDuration = duration_cast<milliseconds>(steady_clock::now() - startTime);
+			cout << "ICE mux: " << openCount.load() << "/" << count << " pairs connected in "
+			     << connectDuration.count() << " ms" << endl;
+
+			if (openCount < count)
+				throw runtime_error("Not all pairs connected");
+
+			// Every offerer sends one message through the mux
+			auto sendTime = steady_clock::now();
+			for (const auto &dc : senders)
+				dc->send("ping");
+
+			deadline = steady_clock::now() + 10s;
+			while (receivedCount < count && steady_clock::now() < deadline)
+				this_thread::sleep_for(1ms);
+
+			auto roundDuration = duration_cast<milliseconds>(steady_clock::now() - sendTime);
+			cout << "ICE mux: " << receivedCount.load() << "/" << count << " messages received in "
+			     << roundDuration.count() << " ms" << endl;
+
+			if (receivedCount < count)
+				throw runtime_error("Not all messages received");
+
+			reached = count;
+
+		} catch (const std::exception &e) {
+			cout << "ICE mux: stopping at " << count << " pairs: " << e.what() << endl;
+		}
+
+		senders.clear();
+		{
+			std::lock_guard lock(mutex);
+			receivers.clear();
+		}
+		for (auto &pc : peers)
+			pc->close();
+
+		peers.clear();
+
+		if (reached != count)
+			break;
+	}
+
+	rtc::Cleanup();
+	return reached;
+}
+
+#if RTC_ENABLE_MEDIA
+// Send H264 keyframes over a loopback video track as fast as possible, the cost is dominated by
+// the RTP/SRTP/UDP send path. Run under "strace -c -f" to count syscalls per packet.
+size_t benchmark_media(milliseconds duration) {
+	rtc::InitLogger(LogLevel::Warning);
+	rtc::Preload();
+
+	PeerConnection pc1;
+	PeerConnection pc2;
+
+	pc1.onLocalDescription([&pc2](Description sdp) { pc2.setRemoteDescription(std::move(sdp)); });
+	pc1.onLocalCandidate(
+	    [&pc2](Candidate candidate) { pc2.addRemoteCandidate(std::move(candidate)); });
+
+	pc2.onLocalDescription([&pc1](Description sdp) { pc1.setRemoteDescription(std::move(sdp)); });
+	pc2.onLocalCandidate(
+	    [&pc1](Candidate candidate) { pc1.addRemoteCandidate(std::move(candidate)); });
+
+	atomic<size_t> receivedPackets = 0;
+	atomic<size_t> receivedSize = 0;
+	pc2.onTrack([&receivedPackets, &receivedSize](shared_ptr<Track> t) {
+		t->onMessage(
+		    [&receivedPackets, &receivedSize](binary message) {
+			    ++receivedPackets;
+			    receivedSize += message.size();
+		    },
+		    nullptr);
+	});
+
+	const uint32_t ssrc = 42;
+	Description::Video media("video", Description::Direction::SendOnly);
+	media.addH264Codec(96);
+	media.addSSRC(ssrc, "video-send");
+	auto t1 = pc1.addTrack(media);
+
+	auto rtpConfig = make_shared<RtpPacketizationConfig>(ssrc, "video-send", 96,
+	                                                     H264RtpPacketizer::defaultClockRate);
+	auto packetizer = make_shared<H264RtpPacketizer>(NalUnit::Separator::Length, rtpConfig);
+	t1->setMediaHandler(make_shared<H264PacketizationHandler>(packetizer));
+
+	pc1.setLocalDescription();
+
+	int attempts = 10;
+	while (!t1->isOpen() && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (!t1->isOpen())
+		throw runtime_error("Track is not open");
+
+	// One length-prefixed IDR NAL unit of about 1 MB
+	const uint32_t nalSize = 1000000;
+	binary frame(4 + nalSize, byte(0xFF));
+	for (int i = 0; i < 4; ++i)
+		frame[i] = byte((nalSize >> (8 * (3 - i))) & 0xFF);
+	frame[4] = byte(0x65);
+
+	size_t sentSize = 0;
+	auto startTime = steady_clock::now();
+	auto startClock = std::clock();
+	while (steady_clock::now() - startTime < duration) {
+		t1->send(frame);
+		sentSize += frame.size();
+		rtpConfig->timestamp += H264RtpPacketizer::defaultClockRate / 30;
+	}
+	auto cpuTime = double(std::clock() - startClock) / CLOCKS_PER_SEC;
+	auto elapsed = duration_cast<milliseconds>(steady_clock::now() - startTime);
+
+	double sentGbits = sentSize * 8 / 1e9;
+	size_t throughput = elapsed.count() > 0 ? sentSize / elapsed.count() : 0; // KB/s
+	cout << "Media sent: " << sentSize / 1000 << " KB in " << elapsed.count() << " ms" << endl;
+	cout << "Media received: " << receivedSize.load() / 1000 << " KB in "
+	     << receivedPackets.load() << " packets" << endl;
+	cout << "Media throughput: " << throughput * 0.001 * 8 << " Mbit/s" << endl;
+	if (sentGbits > 0)
+		cout << "CPU time: " << cpuTime / sentGbits << " s per Gbit sent" << endl;
+
+	pc1.close();
+	pc2.close();
+
+	rtc::Cleanup();
+	return throughput;
+}
+
+// Send RTP packets on tracks with distinct SSRCs sharing one PeerConnection, one thread per
+// track, the number of tracks is doubled at each step. Packets of different SSRCs are protected
+// in parallel, so the packet rate should grow with the number of tracks.
+size_t benchmark_multitrack_send(size_t maxTracks, milliseconds stepDuration) {
+	rtc::InitLogger(LogLevel::Warning);
+	rtc::Preload();
+
+	PeerConnection pc1;
+	PeerConnection pc2;
+
+	pc1.onLocalDescription([&pc2](Description sdp) { pc2.setRemoteDescription(std::move(sdp)); });
+	pc1.onLocalCandidate(
+	    [&pc2](Candidate candidate) { pc2.addRemoteCandidate(std::move(candidate)); });
+
+	pc2.onLocalDescription([&pc1](Description sdp) { pc1.setRemoteDescription(std::move(sdp)); });
+	pc2.onLocalCandidate(
+	    [&pc1](Candidate candidate) { pc1.addRemoteCandidate(std::move(candidate)); });
+
+	atomic<size_t> receivedPackets = 0;
+	pc2.onTrack([&receivedPackets](shared_ptr<Track> t) {
+		t->onMessage([&receivedPackets](binary) { ++receivedPackets; }, nullptr);
+	});
+
+	const SSRC firstSsrc = 1000;
+	vector<shared_ptr<Track>> tracks;
+	for (size_t i = 0; i < maxTracks; ++i) {
+		Description::Video media("video-" + to_string(i), Description::Direction::SendOnly);
+		media.addH264Codec(96);
+		media.addSSRC(firstSsrc + SSRC(i), "video-send-" + to_string(i));
+		tracks.push_back(pc1.addTrack(media));
+	}
+
+	pc1.setLocalDescription();
+
+	auto isOpen = [&tracks]() {
+		for (const auto &t : tracks)
+			if (!t->isOpen())
+				return false;
+		return true;
+	};
+
+	int attempts = 10;
+	while (!isOpen() && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (!isOpen())
+		throw runtime_error("Tracks are not open");
+
+	// Each track needs its own sequence numbers, as SRTP rejects a reused packet index
+	const size_t payloadSize = 1000;
+	vector<uint16_t> seqNumbers(maxTracks, 0);
+
+	size_t rate = 0;
+	for (size_t count = 1; count <= maxTracks; count *= 2) {
+		atomic<size_t> sentPackets = 0;
+		atomic<bool> stop = false;
+		size_t receivedBefore = receivedPackets.load();
+
+		vector<std::thread> threads;
+		for (size_t i = 0; i < count; ++i) {
+			threads.emplace_back([&, i]() {
+				binary packet(sizeof(RtpHeader) + payloadSize, byte(0xFF));
+				auto rtp = reinterpret_cast<RtpHeader *>(packet.data());
+				rtp->preparePacket();
+				rtp->setPayloadType(96);
+				rtp->setSsrc(firstSsrc + SSRC(i));
+
+				size_t sent = 0;
+				try {
+					while (!stop) {
+						rtp->setSeqNumber(seqNumbers[i]++);
+						if (tracks[i]->send(packet))
+							++sent;
+					}
+				} catch (const std::exception &e) {
+					cout << "Send failed: " << e.what() << endl;
+				}
+				sentPackets += sent;
+			});
+		}
+
+		auto startTime = steady_clock::now();
+		this_thread::sleep_for(stepDuration);
+		stop = true;
+		for (auto &thread : threads)
+			thread.join();
+
+		auto elapsed = duration_cast<milliseconds>(steady_clock::now() - startTime);
+		rate = elapsed.count() > 0 ? sentPackets * 1000 / elapsed.count() : 0;
+		cout << "Multitrack: " << count << " tracks, " << rate << " packets/s sent, "
+		     << receivedPackets.load() - receivedBefore << " packets received" << endl;
+	}
+
+	pc1.close();
+	pc2.close();
+
+	rtc::Cleanup();
+	return rate;
+}
+#endif
+
 #ifdef BENCHMARK_MAIN
 int main(int argc, char **argv) {
 	try {
@@ -168,6 +522,29 @@ int main(int argc, char **argv) {
 		if (goodput == 0)
 			throw runtime_error("No data received");
 
+#if RTC_ENABLE_WEBSOCKET
+		size_t rate = benchmark_tls_setup(10s);
+		if (rate == 0)
+			throw runtime_error("No TLS connection established");
+#endif
+
+		// 100 pairs fit in the default limit of 1024 file descriptors, pass a larger maximum as
+		// first argument after raising it with "ulimit -n"
+		size_t maxPairs = argc > 1 ? std::stoul(argv[1]) : 100;
+		size_t pairs = benchmark_ice_mux(maxPairs);
+		if (pairs == 0)
+			throw runtime_error("No ICE mux connection established");
+
+#if RTC_ENABLE_MEDIA
+		size_t throughput = benchmark_media(10s);
+		if (throughput == 0)
+			throw runtime_error("No media sent");
+
+		size_t packetRate = benchmark_multitrack_send(16, 5s);
+		if (packetRate == 0)
+			throw runtime_error("No multitrack media sent");
+#endif
+
 		return 0;
 
 	} catch (const std::exception &e) {
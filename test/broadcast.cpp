@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtc/rtc.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace rtc;
+using namespace std;
+
+namespace {
+
+const uint32_t MessageCount = 1000;
+const size_t MessageSize = 16 * 1024;
+
+// Each message carries its index followed by a pattern derived from it
+binary makeMessage(uint32_t index) {
+	binary message(MessageSize);
+	std::memcpy(message.data(), &index, sizeof(index));
+	for (size_t i = sizeof(index); i < MessageSize; ++i)
+		message[i] = byte((index + i) & 0xFF);
+
+	return message;
+}
+
+struct Receiver {
+	std::atomic<uint32_t> received = 0;
+	std::atomic<uint32_t> next = 0;
+	std::atomic<uint32_t> last = 0;
+	std::atomic<bool> intact = true;
+	std::atomic<bool> ordered = true;
+
+	void onMessage(const binary &message) {
+		uint32_t index = 0;
+		if (message.size() != MessageSize) {
+			intact = false;
+		} else {
+			std::memcpy(&index, message.data(), sizeof(index));
+			if (message != makeMessage(index))
+				intact = false;
+		}
+
+		if (index != next)
+			ordered = false;
+
+		next = index + 1;
+		if (index > last)
+			last = index;
+
+		++received;
+	}
+};
+
+// Remote channels by label
+struct Remote {
+	std::mutex mutex;
+	map<string, shared_ptr<DataChannel>> channels;
+	map<string, shared_ptr<Receiver>> receivers;
+
+	void attach(PeerConnection &pc) {
+		pc.onDataChannel([this](shared_ptr<DataChannel> dc) {
+			auto receiver = std::make_shared<Receiver>();
+			dc->onMessage([receiver](message_variant message) {
+				if (auto data = get_if<binary>(&message))
+					receiver->onMessage(*data);
+			});
+
+			std::lock_guard lock(mutex);
+			receivers.emplace(dc->label(), receiver);
+			channels.emplace(dc->label(), std::move(dc));
+		});
+	}
+
+	shared_ptr<Receiver> receiver(const string &label) {
+		std::lock_guard lock(mutex);
+		auto it = receivers.find(label);
+		return it != receivers.end() ? it->second : nullptr;
+	}
+
+	size_t size() {
+		std::lock_guard lock(mutex);
+		return channels.size();
+	}
+};
+
+void signal(PeerConnection &pc1, PeerConnection &pc2) {
+	pc1.onLocalDescription([&pc2](Description sdp) { pc2.setRemoteDescription(string(sdp)); });
+	pc1.onLocalCandidate(
+	    [&pc2](Candidate candidate) { pc2.addRemoteCandidate(string(candidate)); });
+
+	pc2.onLocalDescription([&pc1](Description sdp) { pc1.setRemoteDescription(string(sdp)); });
+	pc2.onLocalCandidate(
+	    [&pc1](Candidate candidate) { pc1.addRemoteCandidate(string(candidate)); });
+}
+
+} // namespace
+
+void test_broadcast() {
+	InitLogger(LogLevel::Debug);
+
+	// Declared first so they outlive the PeerConnections
+	Remote remoteA, remoteB;
+
+	PeerConnection pcA1, pcA2;
+	PeerConnection pcB1, pcB2;
+	signal(pcA1, pcA2);
+	signal(pcB1, pcB2);
+
+	remoteA.attach(pcA2);
+	remoteB.attach(pcB2);
+
+	// Channels on the same PeerConnection with different reliability share the SCTP transport
+	DataChannelInit latestInit;
+	latestInit.reliability.unordered = true;
+	latestInit.reliability.latestOnly = true;
+	auto reliableA = pcA1.createDataChannel("reliable");
+	auto latestA = pcA1.createDataChannel("latest", latestInit);
+	auto reliableB = pcB1.createDataChannel("reliable");
+	auto closedB = pcB1.createDataChannel("closed");
+
+	int attempts = 10;
+	while ((remoteA.size() < 2 || remoteB.size() < 2 || !reliableA->isOpen() ||
+	        !latestA->isOpen() || !reliableB->isOpen() || !closedB->isOpen()) &&
+	       attempts--)
+		this_thread::sleep_for(1s);
+
+	if (remoteA.size() < 2 || remoteB.size() < 2 || !reliableA->isOpen() || !latestA->isOpen() ||
+	    !reliableB->isOpen() || !closedB->isOpen())
+		throw runtime_error("DataChannels are not open");
+
+	closedB->close();
+	attempts = 10;
+	while (closedB->isOpen() && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (closedB->isOpen())
+		throw runtime_error("DataChannel is not closed");
+
+	// Send far more than the SCTP send buffer can hold, so the latest-only channel drops messages
+	const vector<shared_ptr<DataChannel>> channels = {reliableA, latestA, reliableB, closedB};
+	for (uint32_t i = 0; i < MessageCount; ++i) {
+		size_t sent = DataChannel::Broadcast(channels, makeMessage(i));
+		if (sent != 3)
+			throw runtime_error("Broadcast returned " + to_string(sent) + " instead of 3");
+	}
+
+	auto receiverA = remoteA.receiver("reliable");
+	auto receiverLatest = remoteA.receiver("latest");
+	auto receiverB = remoteB.receiver("reliable");
+	if (!receiverA || !receiverLatest || !receiverB)
+		throw runtime_error("Remote DataChannels are missing");
+
+	attempts = 20;
+	while ((receiverA->received < MessageCount || receiverB->received < MessageCount ||
+	        receiverLatest->last != MessageCount - 1) &&
+	       attempts--)
+		this_thread::sleep_for(1s);
+
+	cout << "Broadcast " << MessageCount << " messages, received " << receiverA->received << " and "
+	     << receiverB->received << " on reliable channels, " << receiverLatest->received
+	     << " on latest-only channel, superseded " << pcA1.messagesSuperseded() << endl;
+
+	auto receiverClosed = remoteB.receiver("closed");
+	if (receiverClosed && receiverClosed->received)
+		throw runtime_error("Closed DataChannel received broadcast messages");
+
+	for (const auto &receiver : {receiverA, receiverLatest, receiverB})
+		if (!receiver->intact)
+			throw runtime_error("Broadcast message was corrupted");
+
+	// Reliable ordered channels must receive every message in order
+	for (const auto &receiver : {receiverA, receiverB})
+		if (receiver->received != MessageCount || !receiver->ordered)
+			throw runtime_error("Reliable DataChannel did not receive all messages in order");
+
+	// The latest-only channel must only drop superseded messages
+	if (receiverLatest->last != MessageCount - 1)
+		throw runtime_error("Latest message was not received on latest-only DataChannel");
+
+	if (pcA1.messagesSuperseded() == 0 || receiverLatest->received >= MessageCount)
+		throw runtime_error("No message was superseded on latest-only DataChannel");
+
+	pcA1.close();
+	pcA2.close();
+	pcB1.close();
+	pcB2.close();
+	this_thread::sleep_for(1s);
+
+	cout << "Success" << endl;
+}
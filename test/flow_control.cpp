@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtc/rtc.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono;
+
+void test_flow_control() {
+	InitLogger(LogLevel::Debug);
+
+	PeerConnection pc1;
+	PeerConnection pc2;
+
+	pc1.onLocalDescription([&pc2](Description sdp) { pc2.setRemoteDescription(string(sdp)); });
+	pc1.onLocalCandidate(
+	    [&pc2](Candidate candidate) { pc2.addRemoteCandidate(string(candidate)); });
+
+	pc2.onLocalDescription([&pc1](Description sdp) { pc1.setRemoteDescription(string(sdp)); });
+	pc2.onLocalCandidate(
+	    [&pc1](Candidate candidate) { pc1.addRemoteCandidate(string(candidate)); });
+
+	shared_ptr<DataChannel> dc2;
+	pc2.onDataChannel([&dc2](shared_ptr<DataChannel> dc) { std::atomic_store(&dc2, dc); });
+
+	auto dc1 = pc1.createDataChannel("flow");
+
+	int attempts = 10;
+	shared_ptr<DataChannel> adc2;
+	while ((!(adc2 = std::atomic_load(&dc2)) || !adc2->isOpen() || !dc1->isOpen()) && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (!adc2 || !adc2->isOpen() || !dc1->isOpen())
+		throw runtime_error("DataChannel is not open");
+
+	// The sender fills the receive queue far past the pause threshold
+	const uint32_t count = 4000;
+	const size_t size = 16 * 1024;
+	std::thread sender([&]() {
+		binary message(size, byte(0));
+		for (uint32_t i = 0; i < count; ++i) {
+			std::memcpy(message.data(), &i, sizeof(i));
+			dc1->send(message);
+		}
+	});
+
+	// The reader is slow at times, then drains the queue completely, so reception is repeatedly
+	// paused and resumed while the sender is still pushing
+	uint32_t received = 0;
+	auto deadline = steady_clock::now() + 60s;
+	while (received < count && steady_clock::now() < deadline) {
+		auto message = adc2->receive();
+		if (!message) {
+			this_thread::sleep_for(1ms);
+			continue;
+		}
+
+		const auto *data = get_if<binary>(&*message);
+		if (!data || data->size() != size)
+			throw runtime_error("Unexpected message");
+
+		uint32_t index;
+		std::memcpy(&index, data->data(), sizeof(index));
+		if (index != received)
+			throw runtime_error("Message received out of order");
+
+		++received;
+		if (received % 256 < 64)
+			this_thread::sleep_for(1ms);
+	}
+
+	sender.join();
+
+	cout << "Received " << received << " of " << count << " messages" << endl;
+	if (received != count)
+		throw runtime_error("Reception stalled");
+
+	pc1.close();
+	pc2.close();
+	this_thread::sleep_for(1s);
+
+	cout << "Success" << endl;
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#if RTC_ENABLE_MEDIA
+
+#include "rtc/rtc.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+static void appendUnit(binary &frame, uint8_t header, size_t payloadSize) {
+	const binary startSequence = {byte(0x00), byte(0x00), byte(0x00), byte(0x01)};
+	frame.insert(frame.end(), startSequence.begin(), startSequence.end());
+	frame.push_back(byte(header));
+	for (size_t i = 0; i < payloadSize; ++i)
+		frame.push_back(byte(1 + i % 251)); // no start sequence in the payload
+}
+
+// Packets go through a media handler chain like on a track, which passes one message per packet
+static vector<message_ptr> depacketize(MediaChainableHandler &handler,
+                                       const vector<binary_ptr> &packets) {
+	vector<message_ptr> result;
+	for (const auto &packet : packets) {
+		auto message = make_message(packet->begin(), packet->end());
+		message->arrivalTime = std::chrono::steady_clock::now();
+		if (auto accessUnit = handler.incoming(message)) {
+			if (accessUnit->arrivalTime != message->arrivalTime)
+				throw runtime_error("Access unit does not carry the arrival time of its packet");
+
+			result.push_back(std::move(accessUnit));
+		}
+	}
+	return result;
+}
+
+static binary_ptr makeStapA(uint16_t seqNumber, uint32_t timestamp, const vector<binary> &units) {
+	auto packet = make_shared<binary>(sizeof(RtpHeader));
+	auto rtp = reinterpret_cast<RtpHeader *>(packet->data());
+	rtp->preparePacket();
+	rtp->setPayloadType(96);
+	rtp->setSeqNumber(seqNumber);
+	rtp->setTimestamp(timestamp);
+	rtp->setSsrc(42);
+	rtp->setMarker(true);
+
+	packet->push_back(byte(0x78)); // NRI 3, STAP-A
+	for (const auto &unit : units) {
+		packet->push_back(byte(unit.size() >> 8));
+		packet->push_back(byte(unit.size() & 0xFF));
+		packet->insert(packet->end(), unit.begin(), unit.end());
+	}
+	return packet;
+}
+
+void test_h264_depacketizer() {
+	InitLogger(LogLevel::Debug);
+
+	// SPS, PPS, then an IDR slice large enough to be fragmented with FU-A
+	binary parameterSets;
+	appendUnit(parameterSets, 0x67, 10);
+	appendUnit(parameterSets, 0x68, 4);
+	binary frame = parameterSets;
+	appendUnit(frame, 0x65, 5000);
+
+	// A non-IDR slice small enough to fit in a single packet
+	binary smallFrame;
+	appendUnit(smallFrame, 0x41, 100);
+
+	auto rtpConfig = make_shared<RtpPacketizationConfig>(42, "video", 96,
+	                                                     H264RtpPacketizer::defaultClockRate);
+	auto packetizer = make_shared<H264RtpPacketizer>(H264RtpPacketizer::Separator::StartSequence,
+	                                                 rtpConfig, 1200);
+
+	auto packetize = [&](const binary &data) {
+		auto product = packetizer->processOutgoingBinaryMessage(
+		    make_chained_messages_product(make_message(data.begin(), data.end())), nullptr);
+		if (!product.messages || product.messages->empty())
+			throw runtime_error("Unexpected packetization");
+
+		rtpConfig->timestamp += 3000;
+		return *product.messages;
+	};
+
+	MediaChainableHandler handler(make_shared<MediaHandlerRootElement>());
+	handler.addToChain(make_shared<H264RtpDepacketizer>());
+
+	auto packets = packetize(frame);
+	cout << "Frame of " << frame.size() << " bytes sent in " << packets.size() << " packets"
+	     << endl;
+	if (packets.size() < 4)
+		throw runtime_error("Frame was not fragmented");
+
+	auto accessUnits = depacketize(handler, packets);
+	if (accessUnits.size() != 1 || *accessUnits[0] != frame)
+		throw runtime_error("Access unit was not reassembled correctly");
+
+	// A lost fragment drops the fragmented unit but keeps the rest of the access unit
+	packets = packetize(frame);
+	packets.erase(packets.begin() + packets.size() / 2 + 1);
+	accessUnits = depacketize(handler, packets);
+	if (accessUnits.size() != 1 || *accessUnits[0] != parameterSets)
+		throw runtime_error("Access unit with a lost fragment was not handled correctly");
+
+	// If the packet with the marker bit is lost, the access unit ends with the next timestamp
+	packets = packetize(frame);
+	packets.pop_back();
+	auto nextPackets = packetize(frame);
+	packets.insert(packets.end(), nextPackets.begin(), nextPackets.end());
+	accessUnits = depacketize(handler, packets);
+	if (accessUnits.size() != 2 || *accessUnits[0] != parameterSets ||
+	    *accessUnits[1] != frame)
+		throw runtime_error("Access unit with a lost marker bit was not handled correctly");
+
+	// If the next access unit is complete in a single packet, it supersedes the unterminated one
+	packets = packetize(frame);
+	packets.pop_back();
+	nextPackets = packetize(smallFrame);
+	if (nextPackets.size() != 1)
+		throw runtime_error("Small frame was not sent in a single packet");
+
+	packets.insert(packets.end(), nextPackets.begin(), nextPackets.end());
+	accessUnits = depacketize(handler, packets);
+	if (accessUnits.size() != 1 || *accessUnits[0] != smallFrame)
+		throw runtime_error("Access unit following a lost marker bit was not passed");
+
+	// Aggregated units are split back into the access unit
+	auto nextSeqNumber = [&]() {
+		return uint16_t(reinterpret_cast<const RtpHeader *>(packets.back()->data())->seqNumber() +
+		                1);
+	};
+	vector<binary> units;
+	binary aggregated;
+	for (auto [header, size] : {pair<uint8_t, size_t>{0x67, 10}, {0x68, 4}, {0x65, 50}}) {
+		binary unit;
+		appendUnit(unit, header, size);
+		aggregated.insert(aggregated.end(), unit.begin(), unit.end());
+		units.emplace_back(unit.begin() + 4, unit.end()); // without start sequence
+	}
+
+	packets = {makeStapA(nextSeqNumber(), rtpConfig->timestamp, units)};
+	accessUnits = depacketize(handler, packets);
+	if (accessUnits.size() != 1 || *accessUnits[0] != aggregated)
+		throw runtime_error("STAP-A packet was not depacketized correctly");
+
+	cout << "Success" << endl;
+}
+
+#endif
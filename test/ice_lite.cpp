@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtc/rtc.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace rtc;
+using namespace std;
+
+static void test_ice_lite_connectivity(bool liteOffers) {
+	Configuration config;
+	// STUN server example
+	// config.iceServers.emplace_back("stun:stun.l.google.com:19302");
+
+	Configuration liteConfig = config;
+	liteConfig.enableIceLite = true;
+
+	PeerConnection fullPc(config);
+	PeerConnection litePc(liteConfig);
+
+	auto &offerer = liteOffers ? litePc : fullPc;
+	auto &answerer = liteOffers ? fullPc : litePc;
+
+	offerer.onLocalDescription([&answerer](Description sdp) {
+		cout << "Offer: " << sdp << endl;
+		answerer.setRemoteDescription(string(sdp));
+	});
+	offerer.onLocalCandidate(
+	    [&answerer](Candidate candidate) { answerer.addRemoteCandidate(string(candidate)); });
+
+	answerer.onLocalDescription([&offerer](Description sdp) {
+		cout << "Answer: " << sdp << endl;
+		offerer.setRemoteDescription(string(sdp));
+	});
+	answerer.onLocalCandidate(
+	    [&offerer](Candidate candidate) { offerer.addRemoteCandidate(string(candidate)); });
+
+	shared_ptr<DataChannel> dc2;
+	answerer.onDataChannel([&dc2](shared_ptr<DataChannel> dc) { std::atomic_store(&dc2, dc); });
+
+	auto dc1 = offerer.createDataChannel("test");
+
+	// The full agent must take the controlling role whichever side offers, otherwise candidate
+	// pairs are never nominated and ICE fails
+	int attempts = 10;
+	while ((!std::atomic_load(&dc2) || !dc1->isOpen()) && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (fullPc.iceState() != PeerConnection::IceState::Connected &&
+	    fullPc.iceState() != PeerConnection::IceState::Completed)
+		throw runtime_error("ICE is not connected");
+
+	if (!dc1->isOpen())
+		throw runtime_error("DataChannel is not open");
+
+	fullPc.close();
+	litePc.close();
+}
+
+void test_ice_lite() {
+	InitLogger(LogLevel::Debug);
+
+	// RFC 8839: "ice-lite" is a session-level attribute
+	const string sdp = "v=0\r\n"
+	                   "o=- 0 0 IN IP4 127.0.0.1\r\n"
+	                   "s=-\r\n"
+	                   "t=0 0\r\n"
+	                   "a=ice-lite\r\n"
+	                   "a=ice-ufrag:ufrag\r\n"
+	                   "a=ice-pwd:passwordpasswordpassword\r\n"
+	                   "a=fingerprint:sha-256 "
+	                   "00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:"
+	                   "00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00\r\n"
+	                   "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n"
+	                   "c=IN IP4 0.0.0.0\r\n"
+	                   "a=mid:0\r\n"
+	                   "a=setup:actpass\r\n"
+	                   "a=sctp-port:5000\r\n";
+
+	if (!Description(sdp, Description::Type::Offer).iceLite())
+		throw runtime_error("Session-level ice-lite attribute was not parsed");
+
+	// A lite agent advertises itself in its description, which requires libnice
+	Configuration liteConfig;
+	liteConfig.enableIceLite = true;
+	bool supported = false;
+	{
+		PeerConnection pc(liteConfig);
+		auto dc = pc.createDataChannel("test");
+		auto description = pc.localDescription();
+		supported = description && description->iceLite();
+		pc.close();
+	}
+
+	if (!supported) {
+		cout << "ICE-lite is not supported, skipping connectivity" << endl;
+		cout << "Success" << endl;
+		return;
+	}
+
+	cout << "Full agent offers to lite agent" << endl;
+	test_ice_lite_connectivity(false);
+
+	cout << "Lite agent offers to full agent" << endl;
+	test_ice_lite_connectivity(true);
+
+	this_thread::sleep_for(1s);
+
+	cout << "Success" << endl;
+}
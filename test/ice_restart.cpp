@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtc/rtc.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono;
+
+void test_ice_restart() {
+	InitLogger(LogLevel::Debug);
+
+	PeerConnection pc1;
+	PeerConnection pc2;
+
+	pc1.onLocalDescription([&pc2](Description sdp) {
+		cout << "Description 1: " << sdp << endl;
+		pc2.setRemoteDescription(string(sdp));
+	});
+
+	pc1.onLocalCandidate([&pc2](Candidate candidate) {
+		cout << "Candidate 1: " << candidate << endl;
+		pc2.addRemoteCandidate(string(candidate));
+	});
+
+	pc2.onLocalDescription([&pc1](Description sdp) {
+		cout << "Description 2: " << sdp << endl;
+		pc1.setRemoteDescription(string(sdp));
+	});
+
+	pc2.onLocalCandidate([&pc1](Candidate candidate) {
+		cout << "Candidate 2: " << candidate << endl;
+		pc1.addRemoteCandidate(string(candidate));
+	});
+
+	std::atomic<int> iceConnectedCount = 0;
+	pc1.onIceStateChange([&iceConnectedCount](PeerConnection::IceState state) {
+		cout << "ICE state 1: " << state << endl;
+		if (state == PeerConnection::IceState::Connected)
+			++iceConnectedCount;
+	});
+
+	shared_ptr<DataChannel> dc2;
+	pc2.onDataChannel([&dc2](shared_ptr<DataChannel> dc) {
+		cout << "DataChannel 2: Received with label \"" << dc->label() << "\"" << endl;
+		std::atomic_store(&dc2, dc);
+	});
+
+	auto dc1 = pc1.createDataChannel("test");
+
+	int attempts = 10;
+	shared_ptr<DataChannel> adc2;
+	while ((!(adc2 = std::atomic_load(&dc2)) || !adc2->isOpen() || !dc1->isOpen()) && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (pc1.state() != PeerConnection::State::Connected ||
+	    pc2.state() != PeerConnection::State::Connected)
+		throw runtime_error("PeerConnection is not connected");
+
+	if (!adc2 || !adc2->isOpen() || !dc1->isOpen())
+		throw runtime_error("DataChannel is not open");
+
+	// Record the largest interval between two consecutive messages during the restart
+	std::mutex mutex;
+	auto last = steady_clock::now();
+	steady_clock::duration maxGap{0};
+	std::atomic<size_t> received = 0;
+	adc2->onMessage([&](const variant<binary, string> &) {
+		std::lock_guard lock(mutex);
+		auto now = steady_clock::now();
+		maxGap = std::max(maxGap, now - last);
+		last = now;
+		++received;
+	});
+
+	std::atomic<bool> sending = true;
+	std::thread sender([&]() {
+		while (sending) {
+			if (dc1->isOpen())
+				dc1->send("Hello during ICE restart");
+
+			this_thread::sleep_for(10ms);
+		}
+	});
+
+	this_thread::sleep_for(1s);
+	{
+		std::lock_guard lock(mutex);
+		last = steady_clock::now();
+		maxGap = steady_clock::duration(0);
+	}
+
+	const auto restart = steady_clock::now();
+	pc1.restartIce();
+
+	attempts = 100;
+	while (iceConnectedCount < 2 && attempts--)
+		this_thread::sleep_for(100ms);
+
+	const auto reconnected = steady_clock::now();
+	this_thread::sleep_for(1s);
+
+	sending = false;
+	sender.join();
+
+	if (iceConnectedCount < 2)
+		throw runtime_error("ICE restart failed");
+
+	if (pc1.state() != PeerConnection::State::Connected ||
+	    pc2.state() != PeerConnection::State::Connected)
+		throw runtime_error("PeerConnection is not connected after ICE restart");
+
+	if (!adc2->isOpen() || !dc1->isOpen())
+		throw runtime_error("DataChannel is not open after ICE restart");
+
+	steady_clock::duration gap;
+	{
+		std::lock_guard lock(mutex);
+		gap = std::max(maxGap, steady_clock::now() - last);
+	}
+
+	cout << "ICE restart completed in "
+	     << duration_cast<milliseconds>(reconnected - restart).count() << " ms, " << received
+	     << " messages received, largest gap "
+	     << duration_cast<milliseconds>(gap).count() << " ms" << endl;
+
+	if (gap > 1s)
+		throw runtime_error("Recovery gap after ICE restart is too long");
+
+	adc2->onMessage(nullptr);
+	pc1.close();
+	pc2.close();
+	this_thread::sleep_for(1s);
+
+	cout << "Success" << endl;
+}
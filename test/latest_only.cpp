@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtc/rtc.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace rtc;
+using namespace std;
+
+void test_latest_only() {
+	InitLogger(LogLevel::Debug);
+
+	PeerConnection pc1;
+	PeerConnection pc2;
+
+	pc1.onLocalDescription([&pc2](Description sdp) { pc2.setRemoteDescription(string(sdp)); });
+	pc1.onLocalCandidate(
+	    [&pc2](Candidate candidate) { pc2.addRemoteCandidate(string(candidate)); });
+
+	pc2.onLocalDescription([&pc1](Description sdp) { pc1.setRemoteDescription(string(sdp)); });
+	pc2.onLocalCandidate(
+	    [&pc1](Candidate candidate) { pc1.addRemoteCandidate(string(candidate)); });
+
+	// Dropping messages would break the contract of a reliable ordered channel
+	DataChannelInit reliableInit;
+	reliableInit.reliability.latestOnly = true;
+	bool rejected = false;
+	try {
+		auto dc = pc1.createDataChannel("reliable", reliableInit);
+	} catch (const invalid_argument &e) {
+		cout << "Reliable latest-only DataChannel rejected: " << e.what() << endl;
+		rejected = true;
+	}
+	if (!rejected)
+		throw runtime_error("Latest-only policy was accepted on a reliable ordered DataChannel");
+
+	const uint32_t count = 2000;
+	const size_t size = 16 * 1024;
+
+	std::atomic<uint32_t> received = 0;
+	std::atomic<uint32_t> last = 0;
+	shared_ptr<DataChannel> dc2;
+	pc2.onDataChannel([&](shared_ptr<DataChannel> dc) {
+		dc->onMessage([&](const variant<binary, string> &message) {
+			if (const auto *data = get_if<binary>(&message); data && data->size() == size) {
+				uint32_t index;
+				std::memcpy(&index, data->data(), sizeof(index));
+				if (index > last) // delivery is unordered
+					last = index;
+
+				++received;
+			}
+		});
+		std::atomic_store(&dc2, dc);
+	});
+
+	// Unordered channels can drop superseded messages
+	DataChannelInit init;
+	init.reliability.unordered = true;
+	init.reliability.latestOnly = true;
+	auto dc1 = pc1.createDataChannel("latest", init);
+
+	int attempts = 10;
+	while ((!std::atomic_load(&dc2) || !dc1->isOpen()) && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (!dc1->isOpen())
+		throw runtime_error("DataChannel is not open");
+
+	// Send far more than the SCTP send buffer can hold
+	binary message(size, byte(0));
+	for (uint32_t i = 0; i < count; ++i) {
+		std::memcpy(message.data(), &i, sizeof(i));
+		dc1->send(message);
+	}
+
+	attempts = 10;
+	while ((dc1->bufferedAmount() > 0 || last != count - 1) && attempts--)
+		this_thread::sleep_for(1s);
+
+	cout << "Sent " << count << " messages, received " << received << ", superseded "
+	     << pc1.messagesSuperseded() << endl;
+
+	if (last != count - 1)
+		throw runtime_error("Latest message was not received");
+
+	if (pc1.messagesSuperseded() == 0 || received >= count)
+		throw runtime_error("No message was superseded");
+
+	pc1.close();
+	pc2.close();
+	this_thread::sleep_for(1s);
+
+	cout << "Success" << endl;
+}
@@ -16,9 +16,21 @@ using namespace std;
 using namespace chrono_literals;
 
 void test_negotiated();
+void test_latest_only();
+void test_broadcast();
+void test_flow_control();
+void test_arrival_time();
+void test_ice_restart();
+void test_ice_lite();
+void test_peerconnection_pool();
+#ifndef _WIN32
+void test_send_scheduler();
+#endif
 void test_connectivity(bool signal_wrong_fingerprint);
 void test_turn_connectivity();
 void test_track();
+void test_h264_depacketizer();
+void test_rtcp_ccfb();
 void test_capi_connectivity();
 void test_capi_track();
 void test_websocket();
@@ -74,6 +86,72 @@ int main(int argc, char **argv) {
 		cerr << "WebRTC negotiated DataChannel test failed: " << e.what() << endl;
 		return -1;
 	}
+	try {
+		cout << endl << "*** Running WebRTC latest-only DataChannel test..." << endl;
+		test_latest_only();
+		cout << "*** Finished WebRTC latest-only DataChannel test" << endl;
+	} catch (const exception &e) {
+		cerr << "WebRTC latest-only DataChannel test failed: " << e.what() << endl;
+		return -1;
+	}
+	try {
+		cout << endl << "*** Running WebRTC DataChannel broadcast test..." << endl;
+		test_broadcast();
+		cout << "*** Finished WebRTC DataChannel broadcast test" << endl;
+	} catch (const exception &e) {
+		cerr << "WebRTC DataChannel broadcast test failed: " << e.what() << endl;
+		return -1;
+	}
+	try {
+		cout << endl << "*** Running WebRTC DataChannel flow control test..." << endl;
+		test_flow_control();
+		cout << "*** Finished WebRTC DataChannel flow control test" << endl;
+	} catch (const exception &e) {
+		cerr << "WebRTC DataChannel flow control test failed: " << e.what() << endl;
+		return -1;
+	}
+	try {
+		cout << endl << "*** Running WebRTC arrival time test..." << endl;
+		test_arrival_time();
+		cout << "*** Finished WebRTC arrival time test" << endl;
+	} catch (const exception &e) {
+		cerr << "WebRTC arrival time test failed: " << e.what() << endl;
+		return -1;
+	}
+	try {
+		cout << endl << "*** Running WebRTC ICE restart test..." << endl;
+		test_ice_restart();
+		cout << "*** Finished WebRTC ICE restart test" << endl;
+	} catch (const exception &e) {
+		cerr << "WebRTC ICE restart test failed: " << e.what() << endl;
+		return -1;
+	}
+	try {
+		cout << endl << "*** Running WebRTC ICE-lite test..." << endl;
+		test_ice_lite();
+		cout << "*** Finished WebRTC ICE-lite test" << endl;
+	} catch (const exception &e) {
+		cerr << "WebRTC ICE-lite test failed: " << e.what() << endl;
+		return -1;
+	}
+	try {
+		cout << endl << "*** Running WebRTC PeerConnection pool test..." << endl;
+		test_peerconnection_pool();
+		cout << "*** Finished WebRTC PeerConnection pool test" << endl;
+	} catch (const exception &e) {
+		cerr << "WebRTC PeerConnection pool test failed: " << e.what() << endl;
+		return -1;
+	}
+#ifndef _WIN32
+	try {
+		cout << endl << "*** Running send scheduler test..." << endl;
+		test_send_scheduler();
+		cout << "*** Finished send scheduler test" << endl;
+	} catch (const exception &e) {
+		cerr << "Send scheduler test failed: " << e.what() << endl;
+		return -1;
+	}
+#endif
 #if RTC_ENABLE_MEDIA
 	try {
 		cout << endl << "*** Running WebRTC Track test..." << endl;
@@ -83,6 +161,22 @@ int main(int argc, char **argv) {
 		cerr << "WebRTC Track test failed: " << e.what() << endl;
 		return -1;
 	}
+	try {
+		cout << endl << "*** Running H264 depacketizer test..." << endl;
+		test_h264_depacketizer();
+		cout << "*** Finished H264 depacketizer test" << endl;
+	} catch (const exception &e) {
+		cerr << "H264 depacketizer test failed: " << e.what() << endl;
+		return -1;
+	}
+	try {
+		cout << endl << "*** Running RTCP congestion control feedback test..." << endl;
+		test_rtcp_ccfb();
+		cout << "*** Finished RTCP congestion control feedback test" << endl;
+	} catch (const exception &e) {
+		cerr << "RTCP congestion control feedback test failed: " << e.what() << endl;
+		return -1;
+	}
 #endif
 #if RTC_ENABLE_WEBSOCKET
 // TODO: Temporarily disabled as the echo service is unreliable
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtc/rtc.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace rtc;
+using namespace std;
+
+static void waitAvailable(const PeerConnectionPool &pool, size_t count) {
+	int attempts = 10;
+	while (pool.available() < count && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (pool.available() < count)
+		throw runtime_error("PeerConnection pool was not refilled");
+}
+
+void test_peerconnection_pool() {
+	InitLogger(LogLevel::Debug);
+
+	Configuration config;
+	// STUN server example
+	// config.iceServers.emplace_back("stun:stun.l.google.com:19302");
+
+	const size_t size = 2;
+	PeerConnectionPool pool(config, size);
+	waitAvailable(pool, size);
+
+	// Acquisitions are served from the pool, which refills in the background
+	auto pc1 = pool.acquire();
+	auto pc2 = pool.acquire();
+	auto stats = pool.stats();
+	cout << "Pool hits: " << stats.hits << ", misses: " << stats.misses << endl;
+	if (stats.hits != 2 || stats.misses != 0)
+		throw runtime_error("PeerConnections were not acquired from the pool");
+
+	waitAvailable(pool, size);
+
+	// Pooled PeerConnections gather their candidates ahead of the first description
+	if (pc1->gatheringState() == PeerConnection::GatheringState::New)
+		throw runtime_error("Pooled PeerConnection did not gather candidates");
+
+	int attempts = 10;
+	while (pc1->gatheringState() != PeerConnection::GatheringState::Complete && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (pc1->gatheringState() != PeerConnection::GatheringState::Complete)
+		throw runtime_error("Pooled PeerConnection did not complete gathering");
+
+	// Without pooled PeerConnections, they are created on demand
+	PeerConnectionPool emptyPool(config, 0);
+	auto pc3 = emptyPool.acquire();
+	stats = emptyPool.stats();
+	if (stats.hits != 0 || stats.misses != 1)
+		throw runtime_error("PeerConnection was not created on demand");
+
+	emptyPool.close();
+
+	// Pooled PeerConnections must be usable like fresh ones
+	std::mutex mutex;
+	optional<Description> firstOffer;
+	pc1->onLocalDescription([pc2, &mutex, &firstOffer](Description sdp) {
+		{
+			std::lock_guard lock(mutex);
+			if (!firstOffer)
+				firstOffer.emplace(sdp);
+		}
+		pc2->setRemoteDescription(string(sdp));
+	});
+	pc1->onLocalCandidate(
+	    [pc2](Candidate candidate) { pc2->addRemoteCandidate(string(candidate)); });
+
+	pc2->onLocalDescription([pc1](Description sdp) { pc1->setRemoteDescription(string(sdp)); });
+	pc2->onLocalCandidate(
+	    [pc1](Candidate candidate) { pc1->addRemoteCandidate(string(candidate)); });
+
+	shared_ptr<DataChannel> dc2;
+	pc2->onDataChannel([&dc2](shared_ptr<DataChannel> dc) { std::atomic_store(&dc2, dc); });
+
+	auto dc1 = pc1->createDataChannel("test");
+
+	attempts = 10;
+	while ((!std::atomic_load(&dc2) || !dc1->isOpen()) && attempts--)
+		this_thread::sleep_for(1s);
+
+	if (!dc1->isOpen())
+		throw runtime_error("DataChannel between pooled PeerConnections is not open");
+
+	{
+		std::lock_guard lock(mutex);
+		if (!firstOffer)
+			throw runtime_error("No offer was issued");
+
+		cout << "First offer: " << *firstOffer << endl;
+		auto candidates = firstOffer->candidates();
+		if (std::none_of(candidates.begin(), candidates.end(), [](const Candidate &candidate) {
+			    return candidate.type() == Candidate::Type::Host;
+		    }))
+			throw runtime_error("First offer of pooled PeerConnection has no host candidate");
+	}
+
+	// The pool can't be used after it is closed
+	pool.close();
+	if (pool.available() != 0)
+		throw runtime_error("PeerConnection pool was not emptied on close");
+
+	bool rejected = false;
+	try {
+		pool.acquire();
+	} catch (const logic_error &) {
+		rejected = true;
+	}
+	if (!rejected)
+		throw runtime_error("PeerConnection was acquired from a closed pool");
+
+	// Break the reference cycles through the callbacks
+	pc1->resetCallbacks();
+	pc2->resetCallbacks();
+	pc1->close();
+	pc2->close();
+	pc3->close();
+	this_thread::sleep_for(1s);
+
+	cout << "Success" << endl;
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#if RTC_ENABLE_MEDIA
+
+#include "rtc/rtc.hpp"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+namespace {
+
+struct Report {
+	bool received;
+	uint8_t ecn;
+	uint16_t arrivalTimeOffset;
+};
+
+struct Block {
+	SSRC ssrc;
+	uint16_t beginSeq;
+	vector<Report> reports;
+};
+
+void check(bool condition, const string &what) {
+	if (!condition)
+		throw runtime_error(what);
+}
+
+} // namespace
+
+void test_rtcp_ccfb() {
+	InitLogger(LogLevel::Debug);
+
+	// Odd metric counts leave 16 bits of padding at the end of the block
+	const vector<Block> blocks = {
+	    {1001, 100, {{true, 0x3, 5}, {false, 0x3, 5}, {true, 0x1, 7}}},
+	    {1002, 65535, {{true, 0x3, 0x1FFF}, {true, 0x0, 1}}},
+	    {1003, 42, {{true, 0x2, 1024}}},
+	};
+
+	check(RtcpCcfbBlock::Size(1) == 12 && RtcpCcfbBlock::Size(2) == 12 &&
+	          RtcpCcfbBlock::Size(3) == 16,
+	      "Unexpected RTCP CCFB block size");
+
+	size_t blocksSize = 0;
+	for (const auto &block : blocks)
+		blocksSize += RtcpCcfbBlock::Size(unsigned(block.reports.size()));
+
+	// Fill the buffer with garbage to check that the padding is cleared
+	binary buffer(RtcpCcfb::Size(blocksSize), byte(0xFF));
+	auto ccfb = reinterpret_cast<RtcpCcfb *>(buffer.data());
+	ccfb->preparePacket(42, blocksSize);
+
+	size_t offset = 0;
+	for (const auto &block : blocks) {
+		auto b = ccfb->getBlock(offset);
+		b->prepareBlock(block.ssrc, block.beginSeq, unsigned(block.reports.size()));
+		for (size_t i = 0; i < block.reports.size(); ++i) {
+			const auto &report = block.reports[i];
+			b->metrics[i].set(report.received, report.ecn, report.arrivalTimeOffset);
+		}
+		offset += b->getSize();
+	}
+
+	ccfb->setReportTimestamp(0xDEADBEEF);
+
+	cout << "RTCP CCFB packet of " << buffer.size() << " bytes" << endl;
+	check(buffer.size() == 8 + 16 + 12 + 12 + 4, "Unexpected RTCP CCFB packet size");
+
+	for (size_t paddingOffset : {8 + 16 - 2, 8 + 16 + 12 + 12 - 2})
+		check(buffer[paddingOffset] == byte(0) && buffer[paddingOffset + 1] == byte(0),
+		      "RTCP CCFB block padding is not cleared");
+
+	// Parse a copy as a received packet
+	const binary received = buffer;
+	auto parsed = reinterpret_cast<const RtcpCcfb *>(received.data());
+	check(parsed->header.payloadType() == 205 && parsed->header.reportCount() == 11,
+	      "Unexpected RTCP CCFB header");
+	check(parsed->header.lengthInBytes() == received.size(), "Unexpected RTCP CCFB length");
+	check(parsed->senderSSRC() == 42, "Unexpected RTCP CCFB sender SSRC");
+	check(parsed->reportTimestamp() == 0xDEADBEEF, "Unexpected RTCP CCFB report timestamp");
+
+	auto parsedBlocks = parsed->blocks();
+	check(parsedBlocks.size() == blocks.size(), "Unexpected RTCP CCFB block count");
+	for (size_t j = 0; j < blocks.size(); ++j) {
+		const auto &block = blocks[j];
+		const auto *b = parsedBlocks[j];
+		check(b->ssrc() == block.ssrc && b->beginSeq() == block.beginSeq &&
+		          b->metricsCount() == block.reports.size(),
+		      "Unexpected RTCP CCFB block");
+
+		for (size_t i = 0; i < block.reports.size(); ++i) {
+			const auto &report = block.reports[i];
+			const auto &metric = b->metrics[i];
+			check(metric.received() == report.received, "Unexpected RTCP CCFB received flag");
+
+			// RFC 8888: ECN and ATO are zero if the packet was not received
+			check(metric.ecn() == (report.received ? report.ecn : 0) &&
+			          metric.arrivalTimeOffset() ==
+			              (report.received ? report.arrivalTimeOffset : 0),
+			      "Unexpected RTCP CCFB metric");
+		}
+	}
+
+	check(parsed->congestionExperiencedCount() == 2,
+	      "Unexpected RTCP CCFB congestion experienced count");
+
+	cout << "Success" << endl;
+}
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2026 agent
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _WIN32 // impl symbols are not exported on Windows
+
+#include "rtc/rtc.hpp"
+
+#include "impl/init.hpp"
+#include "impl/sendscheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+using impl::SendScheduler;
+
+namespace {
+
+const unsigned int DscpAudio = 46;
+const size_t PacketSize = 1000;
+
+// Records the datagrams passed to the ICE transport
+struct Recorder {
+	struct Sent {
+		SendScheduler::Class cls;
+		uint8_t index;
+	};
+
+	mutable std::mutex mutex;
+	vector<Sent> sent;
+
+	SendScheduler::send_function sendFunction() {
+		return [this](const byte *data, size_t size, unsigned int dscp) {
+			std::lock_guard lock(mutex);
+			sent.push_back(Sent{SendScheduler::Classify(data, size, dscp),
+			                    std::to_integer<uint8_t>(data[1])});
+			return true;
+		};
+	}
+
+	size_t count() const {
+		std::lock_guard lock(mutex);
+		return sent.size();
+	}
+
+	vector<Sent> get() const {
+		std::lock_guard lock(mutex);
+		return sent;
+	}
+};
+
+// The first byte selects the class like on the wire, the second one identifies the packet
+binary makePacket(SendScheduler::Class cls, uint8_t index) {
+	binary packet(PacketSize, byte(0));
+	packet[0] = cls == SendScheduler::Class::Video ? byte(0x80) : byte(0x17);
+	packet[1] = byte(index);
+	return packet;
+}
+
+bool sendPacket(SendScheduler &scheduler, SendScheduler::Class cls, uint8_t index) {
+	auto packet = makePacket(cls, index);
+	unsigned int dscp = cls == SendScheduler::Class::Audio ? DscpAudio : 0;
+	return scheduler.send(packet.data(), packet.size(), dscp);
+}
+
+void waitFor(const Recorder &recorder, size_t count, chrono::milliseconds timeout) {
+	auto deadline = chrono::steady_clock::now() + timeout;
+	while (recorder.count() < count && chrono::steady_clock::now() < deadline)
+		this_thread::sleep_for(10ms);
+}
+
+void check(bool condition, const string &what) {
+	if (!condition)
+		throw runtime_error(what);
+}
+
+Configuration makeConfig(size_t rate) {
+	Configuration config;
+	config.sendRateBudget = rate;
+	return config;
+}
+
+} // namespace
+
+void test_send_scheduler() {
+	InitLogger(LogLevel::Debug);
+
+	// The scheduler drains its queues on the thread pool
+	auto token = impl::Init::Instance().token();
+
+	check(SendScheduler::Classify(makePacket(SendScheduler::Class::Data, 0).data(), PacketSize,
+	                              DscpAudio) == SendScheduler::Class::Audio &&
+	          SendScheduler::Classify(makePacket(SendScheduler::Class::Video, 0).data(),
+	                                  PacketSize, 0) == SendScheduler::Class::Video &&
+	          SendScheduler::Classify(makePacket(SendScheduler::Class::Data, 0).data(),
+	                                  PacketSize, 0) == SendScheduler::Class::Data,
+	      "Datagrams are not classified correctly");
+
+	{
+		cout << "Audio bypasses a queued data backlog" << endl;
+		Recorder recorder;
+		auto scheduler =
+		    std::make_shared<SendScheduler>(makeConfig(100 * 1000), recorder.sendFunction());
+
+		// The burst lets the first datagrams through, the others wait for the bucket to refill
+		const uint8_t dataCount = 10;
+		for (uint8_t i = 0; i < dataCount; ++i)
+			check(sendPacket(*scheduler, SendScheduler::Class::Data, i),
+			      "Data datagram was dropped");
+
+		check(recorder.count() < dataCount, "Data datagrams were not queued");
+		check(sendPacket(*scheduler, SendScheduler::Class::Audio, 0), "Audio datagram was dropped");
+
+		waitFor(recorder, dataCount + 1, 2s);
+		auto sent = recorder.get();
+		check(sent.size() == dataCount + 1, "Queued datagrams were not all sent");
+
+		size_t audioPos = 0;
+		while (audioPos < sent.size() && sent[audioPos].cls != SendScheduler::Class::Audio)
+			++audioPos;
+
+		check(audioPos < sent.size() - 1, "Audio datagram was sent after the data backlog");
+		for (size_t i = 0, index = 0; i < sent.size(); ++i)
+			if (sent[i].cls == SendScheduler::Class::Data)
+				check(sent[i].index == index++, "Data datagrams were reordered");
+
+		auto stats = scheduler->stats();
+		check(stats.data.packets == 0 && stats.data.bytes == 0 && stats.audio.packets == 0,
+		      "Queues are not empty after draining");
+		check(stats.data.peakBytes > 0, "Data queue peak was not recorded");
+		scheduler->stop();
+	}
+
+	{
+		cout << "Budget drops and drain rescheduling" << endl;
+		Recorder recorder;
+		auto config = makeConfig(10 * 1000);
+		config.dataSendQueueBudget = 3 * PacketSize;
+		auto scheduler = std::make_shared<SendScheduler>(config, recorder.sendFunction());
+
+		// At 10 KB/s, only the burst goes through right away and the queue quickly overflows
+		const uint8_t count = 10;
+		size_t accepted = 0;
+		for (uint8_t i = 0; i < count; ++i)
+			if (sendPacket(*scheduler, SendScheduler::Class::Data, i))
+				++accepted;
+
+		size_t direct = recorder.count();
+		auto stats = scheduler->stats();
+		cout << "Sent directly: " << direct << ", queued: " << stats.data.packets
+		     << ", dropped: " << stats.data.dropped << endl;
+
+		check(stats.data.packets == 3 && stats.data.bytes == 3 * PacketSize,
+		      "Data queue does not hold its budget");
+		check(stats.data.peakBytes == 3 * PacketSize, "Data queue peak is wrong");
+		check(stats.data.dropped == count - accepted && stats.data.dropped > 0,
+		      "Dropped datagrams are not counted");
+
+		// The queue needs several drains as each one only sends while the bucket is not empty
+		waitFor(recorder, accepted, 2s);
+		check(recorder.count() == accepted, "Drain was not rescheduled after the bucket emptied");
+
+		stats = scheduler->stats();
+		check(stats.data.packets == 0 && stats.data.bytes == 0, "Data queue was not drained");
+
+		scheduler->clearStats();
+		stats = scheduler->stats();
+		check(stats.data.dropped == 0 && stats.data.peakBytes == 0, "Stats were not cleared");
+		scheduler->stop();
+	}
+
+	{
+		cout << "Stop racing pending drains" << endl;
+		for (int round = 0; round < 20; ++round) {
+			Recorder recorder;
+			auto scheduler =
+			    std::make_shared<SendScheduler>(makeConfig(50 * 1000), recorder.sendFunction());
+
+			for (uint8_t i = 0; i < 10; ++i)
+				sendPacket(*scheduler, SendScheduler::Class::Data, i);
+
+			// Let a few drains run, then stop concurrently with the next one
+			std::thread t([scheduler, round]() {
+				this_thread::sleep_for(chrono::milliseconds(round));
+				scheduler->stop();
+			});
+			t.join();
+
+			size_t count = recorder.count();
+			check(!sendPacket(*scheduler, SendScheduler::Class::Audio, 0),
+			      "Datagram was accepted after stop");
+
+			auto stats = scheduler->stats();
+			check(stats.data.packets == 0 && stats.data.bytes == 0,
+			      "Queues were not cleared on stop");
+
+			// Pending drains must neither send nor crash, even once the scheduler is destroyed
+			if (round % 2)
+				scheduler.reset();
+
+			this_thread::sleep_for(50ms);
+			check(recorder.count() == count, "Datagram was sent after stop");
+		}
+	}
+
+	cout << "Success" << endl;
+}
+
+#endif